@@ -0,0 +1,202 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library of the output analyses of the original programs, on the  *
+ * simulation of netsim.c, so that they are written only once:                *
+ *                                                                            *
+ *   a full run          RunSimulation() and ReportSimulation() (nsssn_bp.c)  *
+ *   batch means         BatchAnalysis() (stazionaria.c)                      *
+ *   replications        ReplicateSimulation() (transiente.c)                 *
+ *   horizons            HorizonAnalysis() (a replication of simulate)        *
+ *                                                                            *
+ * BatchAnalysis() cuts a run in batches as stazionaria.c: a batch ends at    *
+ * the first event after more than size departures from the nodes (not from   *
+ * the network), and its mean is the average waiting time of users over the   *
+ * jobs served in it, computed as AvgWait(). It looks at every event with     *
+ * ObserveSimulation(), so the run it observes has the same random numbers   *
+ * and the same events as one without analysis.                               *
+ * ReplicateSimulation() runs the replications one after the other, each      *
+ * from the state of the streams where the one before ended, as transiente.c. *
+ * HorizonAnalysis() runs a replication once up to the last of several STOP   *
+ * and records the average waiting time of users at each of them, the same as *
+ * separate runs with those STOP (the transient mode of simulate, which gives *
+ * every replication streams of its own and runs them on threads).            *
+ *                                                                            *
+ * Name            : analysis.c  (Output Analysis)                            *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <math.h>
+#include <stdlib.h>
+#include "netsim.h" /* simulation of the network */
+#include "analysis.h"
+
+// State of a batch analysis
+typedef struct
+{
+    long size;        // a batch ends after more than size departures
+    int batches;      // batches to observe
+    int current;      // batch being observed
+    long departures;  // departures from the nodes in the current batch
+    double *area;     // time-integrated number of each node in the batch
+    long *served;     // jobs served by each node before the batch
+    double *mean;     // average waiting time of users of each batch
+} batch_state;
+
+// State of a horizon analysis
+typedef struct
+{
+    const double *horizon; // stopping times, increasing
+    int horizons;
+    int current;           // next horizon to reach
+    double *wait;          // average waiting time of users at each horizon
+} horizon_state;
+
+static double BatchMean(const sim_context *s, batch_state *b)
+{
+    /* -------------------------------------------------------------------------- *
+     * the average waiting time of users in the current batch, then the sums of  *
+     * the next batch start from here                                             *
+     * -------------------------------------------------------------------------- */
+    const topology *t = s->top;
+    double avg_wait = 0.0;
+
+    for (int g = 0; g < t->groups; g++)
+    {
+        double wait = 0.0;
+
+        for (int i = t->first[g]; i < t->first[g] + t->count[g]; i++)
+        {
+            wait += b->area[i - 1] /
+                    (double)(s->statistics[i].served - b->served[i - 1]);
+        }
+        avg_wait += wait / t->count[g];
+    }
+    for (int i = 0; i < s->p.servers; i++)
+    {
+        b->area[i] = 0.0;
+        b->served[i] = s->statistics[i + 1].served;
+    }
+    return avg_wait;
+}
+
+static int ObserveBatch(sim_context *s, int e, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * before event e: the areas of the batch up to its time, then the end of the *
+     * batch if it has had enough departures                                      *
+     * -------------------------------------------------------------------------- */
+    batch_state *b = arg;
+
+    for (int i = 0; i < s->p.servers; i++)
+    {
+        if (s->number[i] > 0)
+            b->area[i] += (s->next - s->current) * s->number[i];
+    }
+    if (b->size < b->departures)
+    {
+        b->mean[b->current++] = BatchMean(s, b);
+        b->departures = 0;
+        if (b->current == b->batches)
+            return 0;
+    }
+    if (e != 0)
+        b->departures++;
+    return 1;
+}
+
+int BatchAnalysis(sim_context *s, long size, int batches, double *mean)
+{
+    /* -------------------------------------------------------------------------- *
+     * run s from its initial state and write the means of batches batches in     *
+     * mean (NAN for those not reached when the run ends); return the batches     *
+     * completed, or -1 if out of memory                                          *
+     * -------------------------------------------------------------------------- */
+    batch_state b;
+    int done;
+
+    b.size = size;
+    b.batches = batches;
+    b.current = 0;
+    b.departures = 0;
+    b.area = calloc(s->p.servers, sizeof(double));
+    b.served = calloc(s->p.servers, sizeof(long));
+    b.mean = mean;
+    if (b.area == NULL || b.served == NULL)
+    {
+        free(b.area);
+        free(b.served);
+        return -1;
+    }
+    for (int i = 0; i < s->p.servers; i++)
+        b.served[i] = s->statistics[i + 1].served;
+
+    if (batches > 0)
+        ObserveSimulation(s, ObserveBatch, &b);
+    done = b.current;
+    if (b.current < batches) // the run ended within a batch
+        mean[b.current++] = BatchMean(s, &b);
+    while (b.current < batches)
+        mean[b.current++] = NAN;
+
+    free(b.area);
+    free(b.served);
+    return done;
+}
+
+static void Reach(const sim_context *s, horizon_state *h)
+{
+    /* -------------------------------------------------------------------------- *
+     * the horizons reached: the state at horizon t is the state of a run with    *
+     * STOP t, whose doors close after the last arrival before t                  *
+     * -------------------------------------------------------------------------- */
+    while (h->current < h->horizons && s->arrival >= h->horizon[h->current])
+        h->wait[h->current++] = AvgWait(s);
+}
+
+static int ObserveHorizon(sim_context *s, int e, void *arg)
+{
+    horizon_state *h = arg;
+
+    Reach(s, h);
+    return (h->current < h->horizons);
+}
+
+int HorizonAnalysis(sim_context *s, const double *horizon, int horizons,
+                    double *wait)
+{
+    /* -------------------------------------------------------------------------- *
+     * run s from its initial state (with STOP the last horizon and no purge) and *
+     * write in wait the average waiting time of users at every horizon (NAN for  *
+     * those not reached when the run ends); return the horizons reached          *
+     * -------------------------------------------------------------------------- */
+    horizon_state h;
+
+    h.horizon = horizon;
+    h.horizons = horizons;
+    h.current = 0;
+    h.wait = wait;
+    if (horizons > 0)
+        ObserveSimulation(s, ObserveHorizon, &h);
+    Reach(s, &h);
+    for (int k = h.current; k < horizons; k++)
+        wait[k] = NAN;
+    return h.current;
+}
+
+void ReplicateSimulation(sim_context *s, long replications,
+                         sim_replication *done, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * replications runs of s, the first from its current state, each of the     *
+     * others from the streams left by the one before; done is called at the end  *
+     * of each one                                                                *
+     * -------------------------------------------------------------------------- */
+    for (long r = 0; r < replications; r++)
+    {
+        if (r > 0)
+            InitSimulation(s);
+        RunSimulation(s);
+        done(s, r, arg);
+    }
+}
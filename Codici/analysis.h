@@ -0,0 +1,22 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : analysis.h  (header file for the library analysis.c)     *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_ANALYSIS_)
+#define _ANALYSIS_
+
+#include "netsim.h"
+
+// Called at the end of replication r
+typedef void sim_replication(const sim_context *s, long r, void *arg);
+
+int BatchAnalysis(sim_context *s, long size, int batches, double *mean);
+int HorizonAnalysis(sim_context *s, const double *horizon, int horizons,
+                    double *wait);
+void ReplicateSimulation(sim_context *s, long replications,
+                         sim_replication *done, void *arg);
+
+#endif
@@ -0,0 +1,166 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library for the method of batch means computed on line, while   *
+ * the simulation runs, with a memory that does not grow with the number of   *
+ * observations: no batch mean is stored, only their sums.                    *
+ *                                                                            *
+ * The observations are cut in batches of size observations (level 0); two   *
+ * consecutive batches of level j make a batch of level j + 1, of twice the   *
+ * size. Every level keeps the sums of its batch means (shifted by the first  *
+ * one, for accuracy), of their squares and of the products of consecutive   *
+ * means, which give the sample mean, the standard deviation and the lag-1    *
+ * autocorrelation of the batch means of any size, as the batches are         *
+ * doubled: the number of batches does not have to be known in advance.      *
+ *                                                                            *
+ * ChooseLevel() picks the batch size as the LBATCH rule of G. S. Fishman     *
+ * (Discrete-Event Simulation, 2001): starting from the smallest batches, the *
+ * size is doubled until the lag-1 autocorrelation of the batch means is not  *
+ * significant, that is the batch means can be taken as independent, while   *
+ * there are at least min batches. BatchHalfWidth() is then the half width    *
+ * of the confidence interval of the mean, as in estimate.c.                   *
+ *                                                                            *
+ * Name            : batchmeans.c  (Streaming Batch Means)                    *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <math.h>
+#include <string.h>
+#include "rvms.h" /* random variable models */
+#include "batchmeans.h"
+
+void InitBatchMeans(batch_means *b, long size)
+{
+    /* -------------------------------------------------------------------------- *
+     * no observations, batches of level 0 of size observations                   *
+     * -------------------------------------------------------------------------- */
+    memset(b, 0, sizeof(batch_means));
+    b->size = (size > 0) ? size : 1;
+}
+
+static void AddBatch(batch_means *b, int j, double x)
+{
+    /* -------------------------------------------------------------------------- *
+     * a batch of level j with mean x is complete; every second one completes a   *
+     * batch of level j + 1 too                                                   *
+     * -------------------------------------------------------------------------- */
+    while (j < BM_LEVELS)
+    {
+        bm_level *l = &b->level[j];
+        double d;
+
+        if (l->batches == 0)
+        {
+            l->shift = x;
+            b->levels = j + 1;
+        }
+        else
+            l->s12 += l->last * (x - l->shift);
+        d = x - l->shift;
+        l->s1 += d;
+        l->s2 += d * d;
+        l->last = d;
+        l->batches++;
+
+        if (!l->paired)
+        {
+            l->pending = x;
+            l->paired = 1;
+            return;
+        }
+        x = 0.5 * (l->pending + x);
+        l->paired = 0;
+        j++;
+    }
+}
+
+void AddObservation(batch_means *b, double x)
+{
+    b->observations++;
+    b->sum += x;
+    if (++b->count == b->size)
+    {
+        AddBatch(b, 0, b->sum / b->size);
+        b->count = 0;
+        b->sum = 0.0;
+    }
+}
+
+long Batches(const batch_means *b, int level)
+{
+    return (level >= 0 && level < BM_LEVELS) ? b->level[level].batches : 0;
+}
+
+long BatchSize(const batch_means *b, int level)
+{
+    return b->size << level;
+}
+
+double BatchMean(const batch_means *b, int level)
+{
+    /* -------------------------------------------------------------------------- *
+     * the mean of the batch means of level (the observations after the last     *
+     * complete batch are left out)                                               *
+     * -------------------------------------------------------------------------- */
+    const bm_level *l = &b->level[level];
+
+    if (l->batches == 0)
+        return 0.0;
+    return l->shift + l->s1 / l->batches;
+}
+
+double BatchLag1(const batch_means *b, int level)
+{
+    /* -------------------------------------------------------------------------- *
+     * the lag-1 autocorrelation of the batch means of level, 0 if they are less  *
+     * than 3 or all equal                                                        *
+     * -------------------------------------------------------------------------- */
+    const bm_level *l = &b->level[level];
+    long k = l->batches;
+    double m, sxx, sxy;
+
+    if (k < 3)
+        return 0.0;
+    m = l->s1 / k;               // the mean, shifted; the first mean - shift is 0
+    sxx = l->s2 - k * m * m;
+    sxy = l->s12 - m * (2.0 * l->s1 - l->last) + (k - 1) * m * m;
+    return (sxx > 0.0) ? sxy / sxx : 0.0;
+}
+
+double BatchHalfWidth(const batch_means *b, int level, double loc)
+{
+    /* -------------------------------------------------------------------------- *
+     * half width of the interval for the mean with confidence loc (0.95 for 95%) *
+     * from the batch means of level, 0 if they are less than 2                   *
+     * -------------------------------------------------------------------------- */
+    const bm_level *l = &b->level[level];
+    long k = l->batches;
+    double var;
+
+    if (k < 2)
+        return 0.0;
+    var = (l->s2 - l->s1 * l->s1 / k) / (k - 1);
+    if (var < 0.0)
+        var = 0.0;
+    return idfStudent(k - 1, 1.0 - 0.5 * (1.0 - loc)) * sqrt(var / k);
+}
+
+int ChooseLevel(const batch_means *b, long min, double loc)
+{
+    /* -------------------------------------------------------------------------- *
+     * the smallest batches with a lag-1 autocorrelation not significant at      *
+     * level loc, among the levels with at least min batches; if none, the       *
+     * largest batches that are at least min; -1 if no level has min batches      *
+     * -------------------------------------------------------------------------- */
+    double z = idfNormal(0.0, 1.0, 1.0 - 0.5 * (1.0 - loc));
+    int j;
+
+    if (min < 3)
+        min = 3;
+    for (j = 0; j < b->levels && b->level[j].batches >= min; j++)
+    {
+        if (fabs(BatchLag1(b, j)) <= z / sqrt(b->level[j].batches))
+            return j;
+    }
+    return j - 1;
+}
@@ -0,0 +1,46 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : batchmeans.h  (header file for the library batchmeans.c) *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_BATCHMEANS_)
+#define _BATCHMEANS_
+
+#define BM_LEVELS 48 /* batch sizes: size, 2 size, 4 size, ... */
+
+// Batches of one size, summed as they are completed
+typedef struct
+{
+    long batches;   // batches completed
+    double shift;   // mean of the first batch, subtracted from all the others
+    double s1, s2;  // sums of the batch means - shift, and of their squares
+    double s12;     // sum of the products of consecutive batch means - shift
+    double last;    // last batch mean - shift
+    double pending; // a batch mean waiting for the next, to make a batch of
+    int paired;     //   the level above; 1 if pending holds one
+} bm_level;
+
+// Batch means of a stream of observations, for all the sizes together
+typedef struct
+{
+    long size;                 // observations in a batch of level 0
+    long count;                // observations in the current batch of level 0
+    double sum;                //   and their sum
+    long observations;         // observations added
+    int levels;                // levels with at least one batch
+    bm_level level[BM_LEVELS]; // level j: batches of size * 2^j
+} batch_means;
+
+void InitBatchMeans(batch_means *b, long size);
+void AddObservation(batch_means *b, double x);
+
+long Batches(const batch_means *b, int level);
+long BatchSize(const batch_means *b, int level);
+double BatchMean(const batch_means *b, int level);
+double BatchLag1(const batch_means *b, int level);
+double BatchHalfWidth(const batch_means *b, int level, double loc);
+int ChooseLevel(const batch_means *b, long min, double loc);
+
+#endif
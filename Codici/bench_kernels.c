@@ -0,0 +1,130 @@
+/* -------------------------------------------------------------------------- *
+ * This program measures the gain of the kernels of netsim.c, the loops of    *
+ * the events compiled for a combination of features (here the capacity of    *
+ * the queues) and for the service distribution (the variates computed in     *
+ * place), over the dynamic loop of StepSimulation(), which checks every      *
+ * feature at run time and draws every variate through SampleR().             *
+ * The network is the one of nsssn_bp.c, with Bounded Pareto or Exponential   *
+ * service times (as ver_and_val.c) and infinite or finite AP queues: each    *
+ * case is run with both loops from the same seed, checked to give the same   *
+ * results, and the result is printed in events per second (best of REPEAT). *
+ *                                                                            *
+ * Name            : bench_kernels.c  (Simulation Kernel Benchmark)           *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <time.h>
+#include "rvgs.h"     /* random variate generators  */
+#include "topology.h" /* network topology           */
+#include "netsim.h"   /* simulation of the network  */
+
+#define SEED 123456789
+#define STOP 100000.0 /* about 1.1 million events at LAMBDA   */
+#define LAMBDA 5
+#define CAPACITY 2    /* finite AP queues, to refuse some jobs */
+#define MU_AP 0.332800
+#define MU_SWITCH 46.137344
+#define REPEAT 7
+
+static double Now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static double Events(const sim_context *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * events processed: the arrivals and a departure for each job served        *
+     * -------------------------------------------------------------------------- */
+    double events = s->arrivals;
+
+    for (int i = 1; i <= s->p.servers; i++)
+        events += s->statistics[i].served;
+    return (events);
+}
+
+static double Throughput(sim_context *s, const sim_params *p, int dynamic,
+                         double *avg_wait)
+{
+    /* -------------------------------------------------------------------------- *
+     * events per second of the best of REPEAT runs, with the kernel or with the  *
+     * dynamic loop                                                               *
+     * -------------------------------------------------------------------------- */
+    double best = 0.0;
+
+    for (int k = 0; k < REPEAT; k++)
+    {
+        double start;
+
+        ResetSimulation(s, p, SEED);
+        start = Now();
+        if (dynamic)
+            while (StepSimulation(s))
+                ;
+        else
+            RunSimulation(s);
+        start = Events(s) / (Now() - start);
+        if (start > best)
+            best = start;
+    }
+    *avg_wait = AvgWait(s);
+    return (best);
+}
+
+int main(void)
+{
+    const char *name[] = {"bp", "exp"};
+    sim_params p;
+    topology *t[2];
+
+    DefaultParams(&p);
+    p.stop = STOP;
+    p.lambda = LAMBDA;
+    for (int d = 0; d < 2; d++)
+    {
+        t[d] = CampusTopology(p.servers, p.alpha, p.ap_min, p.ap_max,
+                              p.sw_min, p.sw_max, 0);
+        if (t[d] == NULL)
+        {
+            printf("Error: out of memory\n");
+            return (1);
+        }
+    }
+    ExponentialDist(&t[1]->service[0], 1.0 / MU_AP);
+    ExponentialDist(&t[1]->service[1], 1.0 / MU_SWITCH);
+
+    printf("service capacity      kernel     dynamic   gain   check"
+           "   (events/sec)\n");
+    for (int d = 0; d < 2; d++)
+    {
+        for (int c = 0; c <= CAPACITY; c += CAPACITY)
+        {
+            sim_context *s;
+            double fast, slow, w_fast, w_slow;
+
+            for (int i = 1; i < p.servers; i++)
+                t[d]->capacity[i] = c;
+            p.top = t[d];
+            if ((s = CreateSimulation(&p, SEED)) == NULL)
+            {
+                printf("Error: out of memory\n");
+                return (1);
+            }
+            fast = Throughput(s, &p, 0, &w_fast);
+            slow = Throughput(s, &p, 1, &w_slow);
+            printf("%7s %8s %11.0f %11.0f %5.2fx   %s\n", name[d],
+                   c > 0 ? "finite" : "infinite", fast, slow, fast / slow,
+                   w_fast == w_slow ? "OK" : "Error!!!");
+            FreeSimulation(s);
+        }
+    }
+    FreeTopology(t[0]);
+    FreeTopology(t[1]);
+    return (0);
+}
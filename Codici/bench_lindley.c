@@ -0,0 +1,217 @@
+/* -------------------------------------------------------------------------- *
+ * This program validates the Lindley recursion of lindley.c against the      *
+ * next-event simulation of netsim.c, and measures its speedup.               *
+ * The network is the one of nsssn_bp.c: REPLICATIONS independent runs with   *
+ * each engine (on different streams, since the two consume the random        *
+ * numbers in another order) give the mean of the average waiting time of     *
+ * users and of the utilizations, with 95% confidence intervals, and the      *
+ * interval of the difference between the two engines, which should contain   *
+ * 0. Then one long run with each engine is timed, in jobs per second (best   *
+ * of REPEAT), on the campus with 4 APs and with many more; last, the same    *
+ * run with the decomposition on threads (RunDecomposition), from 2 threads   *
+ * to all the cores, checked to give the same results of RunLindley(); with   *
+ * a single core the threads share it, and no speedup is reported.            *
+ *                                                                            *
+ * Name            : bench_lindley.c  (Lindley Recursion Benchmark)           *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "rvms.h"      /* Student quantiles          */
+#include "replicate.h" /* number of cores            */
+#include "netsim.h"    /* simulation of the network  */
+#include "lindley.h"   /* Lindley recursion          */
+
+#define SEED 123456789
+#define OTHER 987654321 /* seed of the runs of the other engine */
+#define REPLICATIONS 40
+#define STOP 300000.0   /* of the timed runs: 1.5 million jobs */
+#define REPEAT 3
+#define LEVEL 0.95
+
+// Statistics of a run
+#define AVG_WAIT 0
+#define AP_UTILIZATION 1
+#define SWITCH_UTILIZATION 2
+#define STATISTICS 3
+
+static double Now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static int FullRun(sim_context *s, int lindley, int threads)
+{
+    /* -------------------------------------------------------------------------- *
+     * a run with the events, the recursion, or the decomposition on threads      *
+     * -------------------------------------------------------------------------- */
+    if (lindley && threads > 1)
+        return RunDecomposition(s, threads);
+    if (lindley)
+        return RunLindley(s);
+    RunSimulation(s);
+    return 0;
+}
+
+static int Replications(const sim_params *p, int lindley, long seed,
+                        double x[REPLICATIONS][STATISTICS])
+{
+    /* -------------------------------------------------------------------------- *
+     * the statistics of REPLICATIONS runs, each from the streams left by the     *
+     * one before                                                                 *
+     * -------------------------------------------------------------------------- */
+    sim_context *s = CreateSimulation(p, seed);
+
+    if (s == NULL)
+        return -1;
+    for (int r = 0; r < REPLICATIONS; r++)
+    {
+        double ap = 0.0;
+
+        if (r > 0)
+            InitSimulation(s);
+        if (FullRun(s, lindley, 1) != 0)
+        {
+            FreeSimulation(s);
+            return -1;
+        }
+        for (int i = 1; i < s->p.servers; i++)
+            ap += s->statistics[i].service / s->current;
+        x[r][AVG_WAIT] = AvgWait(s);
+        x[r][AP_UTILIZATION] = ap / (s->p.servers - 1);
+        x[r][SWITCH_UTILIZATION] =
+            s->statistics[s->p.servers].service / s->current;
+    }
+    FreeSimulation(s);
+    return 0;
+}
+
+static void Interval(double x[REPLICATIONS][STATISTICS], int k, double *mean,
+                     double *variance)
+{
+    /* -------------------------------------------------------------------------- *
+     * sample mean and variance of statistic k (Welford's algorithm)              *
+     * -------------------------------------------------------------------------- */
+    double m = 0.0, v = 0.0;
+
+    for (int r = 0; r < REPLICATIONS; r++)
+    {
+        double d = x[r][k] - m;
+
+        m += d / (r + 1);
+        v += d * d * r / (r + 1);
+    }
+    *mean = m;
+    *variance = v / (REPLICATIONS - 1);
+}
+
+static double Throughput(const sim_params *p, int lindley, int threads,
+                         double *avg_wait)
+{
+    /* -------------------------------------------------------------------------- *
+     * jobs per second of the best of REPEAT runs                                 *
+     * -------------------------------------------------------------------------- */
+    sim_context *s = CreateSimulation(p, SEED);
+    double best = 0.0;
+
+    *avg_wait = NAN;
+    for (int k = 0; k < REPEAT && s != NULL; k++)
+    {
+        double start;
+
+        ResetSimulation(s, p, SEED);
+        start = Now();
+        if (FullRun(s, lindley, threads) != 0)
+            break;
+        start = s->arrivals / (Now() - start);
+        if (start > best)
+            best = start;
+        *avg_wait = AvgWait(s);
+    }
+    FreeSimulation(s);
+    return (best);
+}
+
+int main(void)
+{
+    const char *name[] = {"avg wait of users", "AP utilization",
+                          "switch utilization"};
+    static double events[REPLICATIONS][STATISTICS];
+    static double lindley[REPLICATIONS][STATISTICS];
+    double t = idfStudent(REPLICATIONS - 1, 1.0 - (1.0 - LEVEL) / 2.0);
+    int servers[] = {5, 65, 257};
+    int cores = DefaultThreads();
+    int error = 0;
+    sim_params p;
+
+    DefaultParams(&p);
+    if (Replications(&p, 0, SEED, events) != 0 ||
+        Replications(&p, 1, OTHER, lindley) != 0)
+    {
+        printf("Error: out of memory\n");
+        return (1);
+    }
+    printf("nsssn_bp.c, %d replications   events              lindley"
+           "             difference\n", REPLICATIONS);
+    for (int k = 0; k < STATISTICS; k++)
+    {
+        double m1, v1, m2, v2, w;
+
+        Interval(events, k, &m1, &v1);
+        Interval(lindley, k, &m2, &v2);
+        w = t * sqrt((v1 + v2) / REPLICATIONS);
+        printf("%-20s %9.6f +/- %.6f %9.6f +/- %.6f %9.6f +/- %.6f  %s\n",
+               name[k], m1, t * sqrt(v1 / REPLICATIONS), m2,
+               t * sqrt(v2 / REPLICATIONS), m2 - m1, w,
+               fabs(m2 - m1) <= w ? "OK" : "Error!!!");
+        error |= fabs(m2 - m1) > w;
+    }
+
+    printf("\nservers      events     lindley  speedup   (jobs/sec)\n");
+    for (int i = 0; i < 3; i++)
+    {
+        double slow, fast, w;
+
+        p.servers = servers[i];
+        p.lambda = 5.0 * (servers[i] - 1) / 4; // the same load of each AP
+        p.stop = STOP * 4 / (servers[i] - 1);  // and the same jobs
+        slow = Throughput(&p, 0, 1, &w);
+        fast = Throughput(&p, 1, 1, &w);
+        printf("%7d %11.0f %11.0f %7.2fx\n", p.servers, slow, fast,
+               fast / slow);
+    }
+
+    printf("\nservers threads    jobs/sec  speedup   check   (decomposition,"
+           " %d cores)\n", cores);
+    if (cores == 1)
+        printf("(a single core: the threads share it, no speedup to measure)\n");
+    for (int i = 0; i < 3; i++)
+    {
+        double base, w_base;
+
+        p.servers = servers[i];
+        p.lambda = 5.0 * (servers[i] - 1) / 4;
+        p.stop = STOP * 4 / (servers[i] - 1);
+        base = Throughput(&p, 1, 1, &w_base);
+        for (int t = 2; t <= 2 * cores || t <= 4; t *= 2)
+        {
+            double w, fast = Throughput(&p, 1, t, &w);
+
+            if (cores > 1)
+                printf("%7d %7d %11.0f %7.2fx   %s\n", p.servers, t, fast,
+                       fast / base, w == w_base ? "OK" : "Error!!!");
+            else
+                printf("%7d %7d %11.0f %8s   %s\n", p.servers, t, fast, "n/a",
+                       w == w_base ? "OK" : "Error!!!");
+            error |= (w != w_base);
+        }
+    }
+    return (error);
+}
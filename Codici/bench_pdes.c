@@ -0,0 +1,125 @@
+/* -------------------------------------------------------------------------- *
+ * This program measures the parallel next-event simulation of pdes.c on a    *
+ * large network: the same run on 1, 2, 4, ... threads (up to the cores, at   *
+ * least 4), in events per second (an arrival and a departure for every job   *
+ * served by a node, best of REPEAT), with the speedup over 1 thread, the     *
+ * rounds of synchronization, and a check that the results do not depend on  *
+ * the threads. The run of netsim.c on the same network is timed too, for     *
+ * reference: its average waiting time of users is statistically, not         *
+ * exactly, the same.                                                         *
+ *                                                                            *
+ * Usage: bench_pdes.o [topology [lambda]]                                    *
+ * The topology is synthetic.top by default, written by gentopo.o, e.g.       *
+ *   gentopo.o 256 16                                                         *
+ *                                                                            *
+ * Name            : bench_pdes.c  (Parallel Simulation Benchmark)            *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "replicate.h" /* number of cores            */
+#include "netsim.h"    /* simulation of the network  */
+#include "pdes.h"      /* parallel simulation        */
+
+#define SEED 123456789
+#define TOPOLOGY "synthetic.top"
+#define LAMBDA 40.0
+#define STOP 20000.0
+#define REPEAT 3
+
+static double Now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static double Throughput(const sim_params *p, int threads, double *avg_wait,
+                         long *rounds)
+{
+    /* -------------------------------------------------------------------------- *
+     * events per second of the best of REPEAT runs, with the events of netsim.c  *
+     * if threads is 0; NAN if the network is not for pdes.c                      *
+     * -------------------------------------------------------------------------- */
+    sim_context *s = CreateSimulation(p, SEED);
+    double best = 0.0;
+
+    *avg_wait = NAN;
+    *rounds = 0;
+    for (int k = 0; k < REPEAT && s != NULL; k++)
+    {
+        double start;
+        long events = 0;
+
+        ResetSimulation(s, p, SEED);
+        start = Now();
+        if (threads == 0)
+            RunSimulation(s);
+        else if (RunParallelSimulation(s, threads, rounds) != 0)
+        {
+            best = NAN;
+            break;
+        }
+        start = Now() - start;
+        for (int i = 1; i <= s->top->nodes; i++)
+            events += 2 * s->statistics[i].served;
+        if (events / start > best)
+            best = events / start;
+        *avg_wait = AvgWait(s);
+    }
+    FreeSimulation(s);
+    return (best);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = (argc > 1) ? argv[1] : TOPOLOGY;
+    topology *t = LoadTopology(path);
+    int cores = DefaultThreads();
+    int error = 0;
+    double base, w_base, w;
+    long rounds;
+    sim_params p;
+
+    if (t == NULL)
+    {
+        printf("Error: cannot load %s (write it with gentopo.o 256 16)\n",
+               path);
+        return (1);
+    }
+    DefaultParams(&p);
+    p.top = t;
+    p.lambda = (argc > 2) ? atof(argv[2]) : LAMBDA;
+    p.stop = STOP;
+
+    base = Throughput(&p, 1, &w_base, &rounds);
+    if (isnan(base))
+    {
+        printf("Error: %s has a link with no lookahead, or no memory\n",
+               path);
+        FreeTopology(t);
+        return (1);
+    }
+    printf("%s: %d nodes, lambda = %g, %d cores\n", path, t->nodes,
+           p.lambda, cores);
+    printf("threads   events/sec  speedup     rounds  avg wait    check\n");
+    printf("%7d %12.0f %7.2fx %10ld %9.6f\n", 1, base, 1.0, rounds, w_base);
+    for (int n = 2; n <= cores || n <= 4; n *= 2)
+    {
+        double fast = Throughput(&p, n, &w, &rounds);
+
+        printf("%7d %12.0f %7.2fx %10ld %9.6f    %s\n", n, fast, fast / base,
+               rounds, w, w == w_base ? "OK" : "Error!!!");
+        error |= (w != w_base);
+    }
+    base = Throughput(&p, 0, &w, &rounds);
+    printf(" events %12.0f %17s %9.6f    (netsim.c)\n", base, "", w);
+    FreeTopology(t);
+    return (error);
+}
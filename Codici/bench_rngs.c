@@ -0,0 +1,131 @@
+/* -------------------------------------------------------------------------- *
+ * This program measures the throughput of the generator of rngs.c: one      *
+ * Random() per call, with and without SelectStream() before each call as in  *
+ * GetArrival() and GetService_AP(), against RandomFill() with blocks of      *
+ * growing size. The result is printed in millions of random numbers per      *
+ * second. Before the measurements, RandomFill() is checked to give exactly   *
+ * the same numbers, and to leave the same state, as the calls to Random(),   *
+ * and TestStreams() checks that the MRG32k3a streams of 2^21 replications    *
+ * do not overlap; the last line is the throughput of MRG32k3a.               *
+ *                                                                            *
+ * Name            : bench_rngs.c  (Random Number Generation Benchmark)       *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <time.h>
+#include "rngs.h" /* the multi-stream generator */
+
+#define SEED 123456789
+#define MAX_BLOCK 4096
+#define DRAWS 20000000 /* random numbers of each measurement */
+#define REPLICATIONS (1L << 21) /* replications checked by TestStreams */
+
+static double Now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static int Check(void)
+{
+    /* -------------------------------------------------------------------------- *
+     * RandomFill against Random, for all the block sizes up to 100 and some      *
+     * larger ones, on several streams                                            *
+     * -------------------------------------------------------------------------- */
+    static double block[MAX_BLOCK];
+    long sizes[] = {0, 1, 7, 8, 9, 100, 1000, MAX_BLOCK};
+    int cases = sizeof(sizes) / sizeof(sizes[0]);
+    rngs_state g;
+    long x, y;
+
+    InitStreamsR(&g);
+    PlantSeedsR(&g, SEED);
+    for (long n = 0; n < 100 + cases; n++)
+    {
+        long size = (n < 100) ? n : sizes[n - 100];
+        int stream = n % 5;
+
+        RandomFillR(StreamR(&g, stream), block, size);
+        SelectStream(stream);
+        for (long i = 0; i < size; i++)
+        {
+            if (Random() != block[i])
+                return (0);
+        }
+        GetSeedR(&g, &x); // the selected stream is still 0
+        SelectStream(0);
+        GetSeed(&y);
+        if (x != y || g.current != 0)
+            return (0);
+    }
+    for (int s = 0; s < 5; s++)
+    {
+        SelectStream(s);
+        SelectStreamR(&g, s);
+        GetSeed(&x);
+        GetSeedR(&g, &y);
+        if (x != y)
+            return (0);
+    }
+    return (1);
+}
+
+int main(void)
+{
+    static double block[MAX_BLOCK];
+    double start, sum = 0.0;
+
+    PlantSeeds(SEED);
+    printf("RandomFill check: %s\n", Check() ? "OK" : "Error!!!");
+    TestStreams(REPLICATIONS);
+    PlantSeeds(SEED);
+
+    printf("%-28s %10s\n", "", "(M/sec)");
+    start = Now();
+    for (long n = 0; n < DRAWS; n++)
+    {
+        SelectStream(0);
+        sum += Random();
+    }
+    printf("%-28s %10.1f\n", "SelectStream + Random", DRAWS / (Now() - start) / 1e6);
+
+    start = Now();
+    for (long n = 0; n < DRAWS; n++)
+        sum += Random();
+    printf("%-28s %10.1f\n", "Random", DRAWS / (Now() - start) / 1e6);
+
+    for (long size = 8; size <= MAX_BLOCK; size *= 8)
+    {
+        char name[32];
+
+        start = Now();
+        for (long n = 0; n < DRAWS; n += size)
+        {
+            RandomFill(0, block, size);
+            sum += block[size - 1];
+        }
+        snprintf(name, sizeof name, "RandomFill, blocks of %ld", size);
+        printf("%-28s %10.1f\n", name, DRAWS / (Now() - start) / 1e6);
+    }
+
+    {
+        rngs_state g;
+        rng_stream *s;
+
+        InitStreamsR(&g);
+        SetGeneratorR(&g, RNG_MRG32K3A);
+        PlantSeedsR(&g, SEED);
+        s = StreamR(&g, 0);
+        start = Now();
+        for (long n = 0; n < DRAWS; n++)
+            sum += RandomR(s);
+        printf("%-28s %10.1f\n", "RandomR, MRG32k3a", DRAWS / (Now() - start) / 1e6);
+    }
+    printf("\n(checksum %f)\n", sum);
+    return (0);
+}
@@ -0,0 +1,169 @@
+/* -------------------------------------------------------------------------- *
+ * This program compares the generators of rvgs.c used by the simulators,     *
+ * called with their parameters, against the distribution objects (rv_dist)   *
+ * with the constants computed once. For each distribution it checks that    *
+ * the two give the same variates, bit for bit, and that their mean is close  *
+ * to DistMean(), then prints millions of variates per second of both.        *
+ * Then it measures the maximum relative error of the batch samplers          *
+ * (SampleFillR) of Exponential and BoundedPareto against SampleR, on the     *
+ * same random numbers, and their throughput with blocks of BLOCK variates.   *
+ *                                                                            *
+ * Name            : bench_rvgs.c  (Random Variate Generation Benchmark)      *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "rngs.h" /* the multi-stream generator   */
+#include "rvgs.h" /* random variate generators    */
+
+#define SEED 123456789
+#define CHECKS 100000
+#define DRAWS 10000000 /* variates of each measurement */
+#define CASES 5
+#define BLOCK 1024
+
+static double Now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static double Function(int c, rng_stream *r)
+{
+    /* -------------------------------------------------------------------------- *
+     * case c with the original function                                          *
+     * -------------------------------------------------------------------------- */
+    switch (c)
+    {
+    case 0:
+        return ExponentialR(r, 1.0 / 10.0);
+    case 1:
+        return ErlangR(r, 4, 0.5);
+    case 2:
+        return NormalR(r, 1.0, 0.5);
+    case 3:
+        return LognormalR(r, 0.0, 0.5);
+    default:
+        return BoundedParetoR(r, 0.5, 0.3756009615, 8.756197416);
+    }
+}
+
+static void Dist(int c, rv_dist *d)
+{
+    switch (c)
+    {
+    case 0:
+        ExponentialDist(d, 1.0 / 10.0);
+        break;
+    case 1:
+        ErlangDist(d, 4, 0.5);
+        break;
+    case 2:
+        NormalDist(d, 1.0, 0.5);
+        break;
+    case 3:
+        LognormalDist(d, 0.0, 0.5);
+        break;
+    default:
+        BoundedParetoDist(d, 0.5, 0.3756009615, 8.756197416);
+    }
+}
+
+int main(void)
+{
+    const char *names[CASES] = {"Exponential", "Erlang", "Normal",
+                                "Lognormal", "BoundedPareto"};
+    rngs_state g, h;
+
+    printf("%-14s %6s %10s %10s %12s %12s\n", "", "check", "mean", "DistMean",
+           "function", "rv_dist");
+    for (int c = 0; c < CASES; c++)
+    {
+        double sum = 0.0, start, function, object;
+        int same = 1;
+        rng_stream *r, *s;
+        rv_dist d;
+
+        Dist(c, &d);
+        InitStreamsR(&g);
+        InitStreamsR(&h);
+        PlantSeedsR(&g, SEED);
+        PlantSeedsR(&h, SEED);
+        r = StreamR(&g, 0);
+        s = StreamR(&h, 0);
+        for (long n = 0; n < CHECKS; n++)
+        {
+            double x = Function(c, r);
+            same = same && (x == SampleR(&d, s));
+            sum += x;
+        }
+
+        start = Now();
+        for (long n = 0; n < DRAWS; n++)
+            sum += Function(c, r);
+        function = DRAWS / (Now() - start) / 1e6;
+        start = Now();
+        for (long n = 0; n < DRAWS; n++)
+            sum += SampleR(&d, s);
+        object = DRAWS / (Now() - start) / 1e6;
+
+        printf("%-14s %6s %10.6f %10.6f %12.1f %12.1f\n", names[c],
+               same ? "OK" : "Error!", sum / (CHECKS + 2 * DRAWS),
+               DistMean(&d), function, object);
+    }
+    printf("\n(M variates/sec)\n\n");
+
+    printf("%-14s %14s %10s %12s %12s\n", "", "max rel error", "same",
+           "SampleR", "SampleFillR");
+    for (int c = 0; c < CASES; c += CASES - 1) // Exponential, BoundedPareto
+    {
+        static double x[BLOCK];
+        double error = 0.0, start, scalar, batch, sum = 0.0;
+        long same = 0;
+        rng_stream *r, *s;
+        rv_dist d;
+
+        Dist(c, &d);
+        InitStreamsR(&g);
+        InitStreamsR(&h);
+        PlantSeedsR(&g, SEED);
+        PlantSeedsR(&h, SEED);
+        r = StreamR(&g, 0);
+        s = StreamR(&h, 0);
+        for (long n = 0; n < DRAWS; n += BLOCK)
+        {
+            SampleFillR(&d, s, x, BLOCK);
+            for (int i = 0; i < BLOCK; i++)
+            {
+                double y = SampleR(&d, r);
+                double e = fabs(x[i] - y) / y;
+
+                error = (e > error) ? e : error;
+                same += (x[i] == y);
+            }
+        }
+
+        start = Now();
+        for (long n = 0; n < DRAWS; n++)
+            sum += SampleR(&d, r);
+        scalar = DRAWS / (Now() - start) / 1e6;
+        start = Now();
+        for (long n = 0; n < DRAWS; n += BLOCK)
+        {
+            SampleFillR(&d, s, x, BLOCK);
+            sum += x[BLOCK - 1];
+        }
+        batch = DRAWS / (Now() - start) / 1e6;
+        printf("%-14s %14.3g %9.1f%% %12.1f %12.1f\n", names[c], error,
+               100.0 * same / DRAWS, scalar, batch);
+        if (sum < 0.0)
+            printf("(checksum %f)\n", sum);
+    }
+    return (0);
+}
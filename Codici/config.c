@@ -0,0 +1,564 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library that reads the configuration of the simulator from a    *
+ * file and from the command line, instead of the #define of the programs.    *
+ * A configuration file has one option per line in the format                 *
+ *                                                                            *
+ *      key = value           # comment                                       *
+ *                                                                            *
+ * and on the command line the same options are given as key=value (or       *
+ * --key=value); the command line overrides the file given with -c FILE.     *
+ * The keys are not case sensitive, so LAMBDA, ALPHA, STOP, CAPACITY, N, K    *
+ * and SERVERS can be used with the names of the old #define.                 *
+ *                                                                            *
+ * Every numeric option can take a list of values and ranges, such as         *
+ *                                                                            *
+ *      lambda = 5, 10, 15                                                    *
+ *      alpha  = 0.5:1.5:0.5  # from 0.5 to 1.5 with step 0.5                 *
+ *                                                                            *
+ * and the configuration then describes the grid of all the combinations of  *
+ * values (the last options in the table vary fastest).                       *
+ *                                                                            *
+ * Name            : config.c  (Configuration of the Simulator)               *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <stddef.h>
+#include "evlist.h"
+#include "netsim.h"
+#include "config.h"
+
+#define REAL 0 /* types of the options */
+#define LONG 1
+#define INT 2
+#define LIST 3 /* choice, by name or number                    */
+#define TEXT 4 /* string, cannot vary in a grid                */
+
+typedef struct
+{
+    const char *name;
+    const char *alias;
+    int type;
+    size_t offset;
+    size_t size;
+    const char *help;
+    const char *const *names; // LIST: names of the values 0, 1, ...
+} option;
+
+#define OPTION(name, alias, type, field, help) \
+    {name, alias, type, offsetof(sim_config, field), sizeof(((sim_config *)0)->field), help, NULL}
+#define CHOICE(name, field, names, help) \
+    {name, NULL, LIST, offsetof(sim_config, field), sizeof(int), help, names}
+
+static const char *const event_lists[] = {"linear", "heap", "dheap", "calendar", NULL};
+static const char *const generators[] = {"lehmer", "mrg32k3a", NULL};
+static const char *const routings[] = {"cdf", "alias", NULL};
+static const char *const engines[] = {"events", "lindley", "pdes", NULL};
+
+static const option table[] = {
+    OPTION("mode", NULL, TEXT, mode, "run, transient, batch, steady or sweep"),
+    CHOICE("engine", engine, engines,
+           "run, sweep: events, lindley (lindley.c) or pdes (pdes.c)"),
+    OPTION("output", NULL, TEXT, output, "file of the results, - for stdout"),
+    OPTION("topology", NULL, TEXT, topology,
+           "topology file, none for the campus of servers"),
+    OPTION("lambda", NULL, REAL, p.lambda, "traffic flow rate"),
+    OPTION("alpha", NULL, REAL, p.alpha, "shape parameter of BP distribution"),
+    OPTION("stop", NULL, REAL, p.stop, "terminal (close the door) time"),
+    OPTION("capacity", NULL, LONG, p.capacity, "AP queue capacity, 0 if infinite"),
+    OPTION("servers", NULL, INT, p.servers, "number of nodes, APs + switch"),
+    OPTION("ap_min", NULL, REAL, p.ap_min, "minimum service time of the APs"),
+    OPTION("ap_max", NULL, REAL, p.ap_max, "maximum service time of the APs"),
+    OPTION("sw_min", NULL, REAL, p.sw_min, "minimum service time of the switch"),
+    OPTION("sw_max", NULL, REAL, p.sw_max, "maximum service time of the switch"),
+    OPTION("streams", NULL, INT, p.streams, "stream of the APs, switch + 1"),
+    CHOICE("event_list", p.event_list, event_lists,
+           "linear, heap, dheap or calendar"),
+    CHOICE("generator", p.generator, generators, "lehmer or mrg32k3a"),
+    CHOICE("routing", p.routing, routings, "cdf (as nsssn_bp.c) or alias"),
+    OPTION("buffer", NULL, LONG, p.buffer,
+           "variates generated in blocks, 0 one at a time"),
+    OPTION("crn", NULL, INT, p.crn,
+           "transient: 1 for a stream for each random purpose, and paired "
+           "differences with the first point"),
+    OPTION("exact", NULL, INT, p.exact,
+           "1 for the areas of every node at every event, as nsssn_bp.c"),
+    OPTION("seed", NULL, LONG, seed, "initial seed"),
+    OPTION("replications", NULL, LONG, replications,
+           "transient: number of replications"),
+    OPTION("horizons", NULL, TEXT, horizons,
+           "transient: stopping times of one pass, as 105,210,410"),
+    OPTION("departures", "N", LONG, departures, "batch: departures to simulate"),
+    OPTION("batches", "K", LONG, batches,
+           "batch: number of batches, steady: at least K"),
+    OPTION("batch_size", NULL, LONG, batch_size,
+           "steady: departures in the smallest batches"),
+    OPTION("confidence", NULL, REAL, confidence,
+           "level of confidence of the intervals"),
+    OPTION("precision", NULL, REAL, precision,
+           "steady, transient: relative half width to reach, 0 for none"),
+    OPTION("runs", NULL, INT, runs, "batch: number of stream sets"),
+    OPTION("threads", NULL, INT, threads, "threads, 0 for all the cores"),
+};
+
+#define OPTIONS (int)(sizeof(table) / sizeof(table[0]))
+
+static void *Field(sim_config *c, int i)
+{
+    return (char *)c + table[i].offset;
+}
+
+static double GetValue(const sim_config *c, int i)
+{
+    const void *f = (const char *)c + table[i].offset;
+
+    switch (table[i].type)
+    {
+    case REAL:
+        return *(const double *)f;
+    case LONG:
+        return (double)*(const long *)f;
+    default:
+        return (double)*(const int *)f;
+    }
+}
+
+static void PutValue(sim_config *c, int i, double v)
+{
+    switch (table[i].type)
+    {
+    case REAL:
+        *(double *)Field(c, i) = v;
+        break;
+    case LONG:
+        *(long *)Field(c, i) = (long)v;
+        break;
+    case INT:
+    case LIST:
+        *(int *)Field(c, i) = (int)v;
+        break;
+    }
+}
+
+static int FindOption(const char *key)
+{
+    for (int i = 0; i < OPTIONS; i++)
+    {
+        if (strcasecmp(key, table[i].name) == 0 ||
+            (table[i].alias != NULL && strcasecmp(key, table[i].alias) == 0))
+            return i;
+    }
+    return -1;
+}
+
+static char *Trim(char *s)
+{
+    char *end;
+
+    while (isspace((unsigned char)*s))
+        s++;
+    end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1]))
+        *--end = '\0';
+    return s;
+}
+
+static int ParseNumber(int i, const char *s, double *v)
+{
+    /* -------------------------------------------------------------------------- *
+     * parse one value of option i, return 0 on success                           *
+     * -------------------------------------------------------------------------- */
+    char *end;
+
+    if (table[i].type == LIST)
+    {
+        for (int k = 0; table[i].names[k] != NULL; k++)
+        {
+            if (strcasecmp(s, table[i].names[k]) == 0)
+            {
+                *v = k;
+                return 0;
+            }
+        }
+    }
+    *v = strtod(s, &end);
+    return (end == s || *Trim(end) != '\0') ? -1 : 0;
+}
+
+void DefaultConfig(sim_grid *g)
+{
+    /* -------------------------------------------------------------------------- *
+     * default configuration: the parameters of nsssn_bp.c and stazionaria.c      *
+     * -------------------------------------------------------------------------- */
+    sim_config *c = &g->base;
+
+    memset(g, 0, sizeof(sim_grid));
+    DefaultParams(&c->p);
+    strcpy(c->mode, "run");
+    strcpy(c->output, "-");
+    c->seed = 123456789;
+    c->replications = 100;
+    c->departures = 400000;
+    c->batches = 64;
+    c->batch_size = 1000;
+    c->confidence = 0.95;
+    c->runs = 10;
+    c->threads = 0;
+
+    g->options = OPTIONS;
+    for (int i = 0; i < OPTIONS; i++)
+    {
+        if (table[i].type != TEXT)
+        {
+            g->count[i] = 1;
+            g->value[i][0] = GetValue(c, i);
+        }
+    }
+}
+
+int SetOption(sim_grid *g, const char *key, const char *value)
+{
+    /* -------------------------------------------------------------------------- *
+     * set an option to a value or to a list of values, return 0 on success       *
+     * -------------------------------------------------------------------------- */
+    char buffer[1024];
+    char *item, *save;
+    int i = FindOption(key);
+    int n = 0;
+
+    if (i < 0)
+    {
+        fprintf(stderr, "Error: unknown option '%s'\n", key);
+        return -1;
+    }
+    if (strlen(value) >= sizeof(buffer))
+    {
+        fprintf(stderr, "Error: value of '%s' too long\n", key);
+        return -1;
+    }
+    strcpy(buffer, value);
+
+    if (table[i].type == TEXT)
+    {
+        char *s = Trim(buffer);
+        if (strlen(s) >= table[i].size)
+        {
+            fprintf(stderr, "Error: value of '%s' too long\n", key);
+            return -1;
+        }
+        strcpy(Field(&g->base, i), s);
+        return 0;
+    }
+
+    for (item = strtok_r(buffer, ",", &save); item != NULL;
+         item = strtok_r(NULL, ",", &save))
+    {
+        double from, to, step = 1.0;
+        char *colon = strchr(item, ':');
+
+        item = Trim(item);
+        if (colon == NULL)
+        {
+            if (ParseNumber(i, item, &from) != 0)
+                break;
+            to = from;
+        }
+        else
+        { // range from:to[:step]
+            char *second = strchr(colon + 1, ':');
+            *colon = '\0';
+            if (second != NULL)
+            {
+                *second = '\0';
+                if (ParseNumber(i, Trim(second + 1), &step) != 0 || step <= 0.0)
+                    break;
+            }
+            if (ParseNumber(i, Trim(item), &from) != 0 ||
+                ParseNumber(i, Trim(colon + 1), &to) != 0)
+                break;
+        }
+        for (long k = 0; from + k * step <= to + 1e-9 * step; k++)
+        {
+            if (n == MAX_VALUES)
+            {
+                fprintf(stderr, "Error: too many values for '%s'\n", key);
+                return -1;
+            }
+            g->value[i][n++] = from + k * step;
+        }
+    }
+    if (item != NULL || n == 0)
+    {
+        fprintf(stderr, "Error: bad value '%s' for '%s'\n", value, key);
+        return -1;
+    }
+    g->count[i] = n;
+    PutValue(&g->base, i, g->value[i][0]);
+    return 0;
+}
+
+int ReadConfig(sim_grid *g, const char *path)
+{
+    /* -------------------------------------------------------------------------- *
+     * read a configuration file, return 0 on success                             *
+     * -------------------------------------------------------------------------- */
+    char line[1024];
+    int number = 0;
+    FILE *f = fopen(path, "r");
+
+    if (f == NULL)
+    {
+        fprintf(stderr, "Error: cannot open '%s'\n", path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        char *s = line;
+        char *equal;
+
+        number++;
+        s[strcspn(s, "#\n")] = '\0';
+        s = Trim(s);
+        if (*s == '\0')
+            continue;
+        equal = strchr(s, '=');
+        if (equal == NULL)
+        {
+            fprintf(stderr, "Error: %s:%d: expected key = value\n", path, number);
+            fclose(f);
+            return -1;
+        }
+        *equal = '\0';
+        if (SetOption(g, Trim(s), Trim(equal + 1)) != 0)
+        {
+            fprintf(stderr, "  at %s:%d\n", path, number);
+            fclose(f);
+            return -1;
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+int ParseArguments(sim_grid *g, int argc, char *argv[])
+{
+    /* -------------------------------------------------------------------------- *
+     * read the command line: -c FILE, key=value or --key=value; return 0 on      *
+     * success, 1 if the help was requested and -1 on errors                      *
+     * -------------------------------------------------------------------------- */
+    for (int i = 1; i < argc; i++)
+    {
+        char key[64];
+        const char *arg = argv[i];
+        const char *equal;
+
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0)
+        {
+            PrintOptions(stdout);
+            return 1;
+        }
+        if (strcmp(arg, "-c") == 0 || strcmp(arg, "--config") == 0)
+        {
+            if (i + 1 == argc || ReadConfig(g, argv[++i]) != 0)
+                return -1;
+            continue;
+        }
+        while (*arg == '-')
+            arg++;
+        equal = strchr(arg, '=');
+        if (equal == NULL || equal - arg >= (long)sizeof(key))
+        {
+            fprintf(stderr, "Error: expected key=value, got '%s'\n", argv[i]);
+            return -1;
+        }
+        memcpy(key, arg, equal - arg);
+        key[equal - arg] = '\0';
+        if (strcmp(key, "config") == 0)
+        {
+            if (ReadConfig(g, equal + 1) != 0)
+                return -1;
+        }
+        else if (SetOption(g, key, equal + 1) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+void PrintOptions(FILE *f)
+{
+    fprintf(f, "usage: simulate [-c FILE] [key=value ...]\n\n");
+    for (int i = 0; i < OPTIONS; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%s%s%s", table[i].name,
+                 table[i].alias ? ", " : "", table[i].alias ? table[i].alias : "");
+        fprintf(f, "  %-16s %s\n", name, table[i].help);
+    }
+    fprintf(f, "\nnumeric options take lists and ranges: lambda=5,10,15 "
+               "alpha=0.5:1.5:0.5\n");
+}
+
+void WriteConfig(FILE *f, const sim_config *c)
+{
+    /* -------------------------------------------------------------------------- *
+     * write the configuration c in the format of a configuration file            *
+     * -------------------------------------------------------------------------- */
+    for (int i = 0; i < OPTIONS; i++)
+    {
+        const void *field = (const char *)c + table[i].offset;
+
+        if (table[i].type == TEXT)
+            fprintf(f, "%-12s = %s\n", table[i].name, (const char *)field);
+        else if (table[i].type == LIST)
+            fprintf(f, "%-12s = %s\n", table[i].name,
+                    table[i].names[*(const int *)field]);
+        else
+            fprintf(f, "%-12s = %.17g\n", table[i].name, GetValue(c, i));
+    }
+}
+
+int Horizons(const sim_config *c, double *t, int max)
+{
+    /* -------------------------------------------------------------------------- *
+     * the stopping times of the transient analysis, in increasing order: the    *
+     * horizons, or stop if there are none; return their number, -1 if they are   *
+     * not valid or more than max                                                 *
+     * -------------------------------------------------------------------------- */
+    const char *s = c->horizons;
+    int n = 0;
+
+    if (*s == '\0')
+    {
+        t[0] = c->p.stop;
+        return 1;
+    }
+    while (*s != '\0')
+    {
+        char *end;
+        double x = strtod(s, &end);
+
+        if (end == s || n == max || x <= 0.0 || (n > 0 && x <= t[n - 1]))
+            return -1;
+        t[n++] = x;
+        while (isspace((unsigned char)*end))
+            end++;
+        if (*end == ',')
+            end++;
+        else if (*end != '\0')
+            return -1;
+        s = end;
+    }
+    return n;
+}
+
+int CheckConfig(const sim_config *c)
+{
+    /* -------------------------------------------------------------------------- *
+     * validate a configuration, return 0 if it can be simulated                  *
+     * -------------------------------------------------------------------------- */
+    const sim_params *p = &c->p;
+    const char *error = NULL;
+    double t[MAX_VALUES];
+
+    if (strcmp(c->mode, "run") != 0 && strcmp(c->mode, "transient") != 0 &&
+        strcmp(c->mode, "batch") != 0 && strcmp(c->mode, "steady") != 0 &&
+        strcmp(c->mode, "sweep") != 0)
+        error = "mode must be run, transient, batch, steady or sweep";
+    else if (c->engine < ENGINE_EVENTS || c->engine > ENGINE_PDES)
+        error = "unknown engine";
+    else if (p->lambda <= 0.0 || p->stop <= 0.0)
+        error = "lambda and stop must be positive";
+    else if (p->alpha <= 0.0)
+        error = "alpha must be positive";
+    else if (p->ap_min <= 0.0 || p->ap_max <= p->ap_min ||
+             p->sw_min <= 0.0 || p->sw_max <= p->sw_min)
+        error = "service bounds must be 0 < min < max";
+    else if (p->servers < 2)
+        error = "at least one AP and the switch are needed";
+    else if (p->capacity < 0 || p->buffer < 0)
+        error = "capacity and buffer must be 0 or positive";
+    else if (p->streams < 1 || p->streams + 1 >= STREAMS)
+        error = "streams must be between 1 and 254";
+    else if (p->event_list < EVENT_LINEAR || p->event_list > EVENT_CALENDAR ||
+             p->generator < RNG_LEHMER || p->generator > RNG_MRG32K3A ||
+             p->routing < ROUTE_CDF || p->routing > ROUTE_ALIAS)
+        error = "unknown event list, generator or routing";
+    else if (c->replications < 1 || c->batches < 1 ||
+             c->departures < c->batches || c->runs < 1)
+        error = "replications, batches and runs must be positive, N >= K";
+    else if ((c->runs + 1) * (p->top != NULL ? p->top->groups : 2) > STREAMS &&
+             (strcmp(c->mode, "batch") == 0 || strcmp(c->mode, "steady") == 0))
+        error = "the stream sets of the runs, (runs + 1) * groups, must be "
+                "at most 256";
+    else if (c->batch_size < 1 || c->confidence <= 0.0 ||
+             c->confidence >= 1.0)
+        error = "batch_size must be positive, 0 < confidence < 1";
+    else if (c->precision < 0.0 || c->precision >= 1.0)
+        error = "precision must be 0 (none) or between 0 and 1";
+    else if (p->crn != 0 && p->crn != 1)
+        error = "crn must be 0 or 1";
+    else if ((p->exact != 0 && p->exact != 1) ||
+             (p->exact && c->engine != ENGINE_EVENTS))
+        error = "exact must be 0 or 1, and 1 only with the events engine";
+    else if (p->crn && (p->buffer > 0 || strcmp(c->mode, "transient") != 0))
+        error = "crn is for the transient mode (paired differences), with "
+                "buffer = 0";
+    else if (p->crn && SimulationStreams(p) > STREAMS)
+        error = "with crn, streams + groups + nodes must be less than 256";
+    else if (Horizons(c, t, MAX_VALUES) < 0)
+        error = "horizons must be increasing positive times, as 105,210,410";
+    if (error != NULL)
+    {
+        fprintf(stderr, "Error: %s\n", error);
+        return -1;
+    }
+    return 0;
+}
+
+long GridPoints(const sim_grid *g)
+{
+    long n = 1;
+
+    for (int i = 0; i < g->options; i++)
+    {
+        if (g->count[i] > 0)
+            n *= g->count[i];
+    }
+    return (n);
+}
+
+void GridPoint(const sim_grid *g, long k, sim_config *c)
+{
+    /* -------------------------------------------------------------------------- *
+     * configuration of the point k (0 <= k < GridPoints) of the grid             *
+     * -------------------------------------------------------------------------- */
+    *c = g->base;
+    for (int i = g->options - 1; i >= 0; i--)
+    {
+        if (g->count[i] > 0)
+        {
+            PutValue(c, i, g->value[i][k % g->count[i]]);
+            k /= g->count[i];
+        }
+    }
+}
+
+void PrintPoint(FILE *f, const sim_grid *g, const sim_config *c)
+{
+    /* -------------------------------------------------------------------------- *
+     * print the options that change in the grid, in a comment line              *
+     * -------------------------------------------------------------------------- */
+    fprintf(f, "#");
+    for (int i = 0; i < g->options; i++)
+    {
+        if (g->count[i] > 1)
+            fprintf(f, " %s=%g", table[i].name, GetValue(c, i));
+    }
+    fprintf(f, "\n");
+}
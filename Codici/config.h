@@ -0,0 +1,66 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : config.h  (header file for the library config.c)         *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_CONFIG_)
+#define _CONFIG_
+
+#include <stdio.h>
+#include "netsim.h"
+
+#define MAX_VALUES 256 /* values of a parameter in a grid */
+#define MAX_OPTIONS 48 /* options of the simulator        */
+
+#define ENGINE_EVENTS 0        /* next-event simulation (netsim.c)      */
+#define ENGINE_LINDLEY 1       /* Lindley recursion, if the network     */
+                               /*   allows it (lindley.c)               */
+#define ENGINE_PDES 2          /* next-event simulation on threads      */
+                               /*   (pdes.c)                            */
+
+// Configuration of one run of the simulator
+typedef struct
+{
+    sim_params p;       // parameters of the model
+    char mode[16];      // run, transient, batch, steady or sweep
+    int engine;         // run, sweep: ENGINE_EVENTS, _LINDLEY, ...
+    long seed;          // initial seed
+    long replications;  // transient: number of replications
+    char horizons[256]; // transient: stopping times of a single pass
+    long departures;    // batch: N, departures to simulate
+    long batches;       // batch: K, number of batches (steady: at least K)
+    long batch_size;    // steady: departures in the smallest batches
+    double confidence;  // level of confidence of the intervals
+    double precision;   // relative half width to reach, 0 for fixed N or
+                        //   replications (then the limits of the analysis)
+    int runs;           // batch: stream sets, as in stazionaria.c
+    int threads;        // 0 for all the cores
+    char output[256];   // file of the results, - for stdout
+    char topology[256]; // topology file (see topology.c), empty for the campus
+} sim_config;
+
+// Grid of configurations: every option can take a list of values
+typedef struct
+{
+    sim_config base;
+    int options;               // number of options
+    int count[MAX_OPTIONS];    // values of each option
+    double value[MAX_OPTIONS][MAX_VALUES];
+} sim_grid;
+
+void DefaultConfig(sim_grid *g);
+int SetOption(sim_grid *g, const char *key, const char *value);
+int ReadConfig(sim_grid *g, const char *path);
+int ParseArguments(sim_grid *g, int argc, char *argv[]);
+void PrintOptions(FILE *f);
+void WriteConfig(FILE *f, const sim_config *c);
+int CheckConfig(const sim_config *c);
+int Horizons(const sim_config *c, double *t, int max);
+
+long GridPoints(const sim_grid *g);
+void GridPoint(const sim_grid *g, long k, sim_config *c);
+void PrintPoint(FILE *f, const sim_grid *g, const sim_config *c);
+
+#endif
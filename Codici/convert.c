@@ -0,0 +1,283 @@
+/* -------------------------------------------------------------------------- *
+ * This program converts the results of the simulations between the text     *
+ * layout of the original programs and the binary result files (results.c):  *
+ *                                                                            *
+ *   convert.o file.res [file.txt]     binary to text (stdout if no file)     *
+ *   convert.o -f file.res [file.txt]  the same, with %f as the programs      *
+ *   convert.o -b file.txt file.res    text to binary                         *
+ *                                                                            *
+ * The text has one row per line and the columns separated by blanks; the    *
+ * metadata are written as comment lines (#) and the names of the columns in *
+ * the last comment line. Values are written with %.17g, so a file converted  *
+ * to text and back is the same, or with %f (-f), as file.txt of transiente.c.*
+ *                                                                            *
+ * From text, the comment lines are the metadata, and the last one before the *
+ * data gives the names of the columns if it has a word for each column       *
+ * (else they are c1, c2, ...). The output of stazionaria.c, blocks of a      *
+ * single column separated by empty lines (one per run), becomes one column   *
+ * per block, run_1, run_2, ...; in any other text the empty lines are        *
+ * skipped.                                                                   *
+ *                                                                            *
+ * Name            : convert.c  (Result Conversion)                           *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "results.h" // binary result files
+
+#define MAX_COLUMNS 256
+
+// A text file read in memory
+typedef struct
+{
+    double *x;         // values, by rows
+    long n, size;      // values read and allocated
+    int columns;       // columns of a row
+    long *block;       // first row of each block of lines
+    long blocks;
+    char *meta;        // comment lines
+    size_t length;
+    char names[1024];  // last comment line before the data, not in meta
+} text;
+
+static int ToText(const char *in, const char *out, const char *format)
+{
+    /* -------------------------------------------------------------------------- *
+     * write the result file in as text                                           *
+     * -------------------------------------------------------------------------- */
+    result_file *r = MapResults(in);
+    FILE *f = stdout;
+    const char *m;
+
+    if (r == NULL)
+    {
+        printf("Error: '%s' is not a result file\n", in);
+        return 1;
+    }
+    if (out != NULL && (f = fopen(out, "w")) == NULL)
+    {
+        printf("Error: cannot write '%s'\n", out);
+        UnmapResults(r);
+        return 1;
+    }
+    for (m = r->meta; *m != '\0';)
+    { // one comment line per line of metadata
+        size_t n = strcspn(m, "\n");
+
+        fprintf(f, (*m == '#') ? "%.*s\n" : "# %.*s\n", (int)n, m);
+        m += n + (m[n] == '\n');
+    }
+    fprintf(f, "#");
+    for (int c = 0; c < r->columns; c++)
+        fprintf(f, " %s", r->name[c]);
+    fprintf(f, "\n");
+    for (long i = 0; i < r->rows; i++)
+    {
+        for (int c = 0; c < r->columns; c++)
+        {
+            fprintf(f, format, ResultColumn(r, c)[i]);
+            fputc((c + 1 < r->columns) ? ' ' : '\n', f);
+        }
+    }
+    UnmapResults(r);
+    if (f != stdout && fclose(f) != 0)
+        return 1;
+    return 0;
+}
+
+static int Read(text *t, FILE *f)
+{
+    /* -------------------------------------------------------------------------- *
+     * the values of a text file, with its blocks and comments                    *
+     * -------------------------------------------------------------------------- */
+    char *line = NULL;
+    size_t n = 0;
+    int empty = 1; // the last line was empty (or there is none)
+    FILE *meta = open_memstream(&t->meta, &t->length);
+
+    if (meta == NULL)
+        return -1;
+    while (getline(&line, &n, f) >= 0)
+    {
+        char *s = line + strspn(line, " \t\r\n");
+        int c = 0;
+
+        if (*s == '#')
+        { // before the data, the last comment line may be the names
+            s[strcspn(s, "\r\n")] = '\0';
+            if (t->columns > 0)
+                fprintf(meta, "%s\n", s + 1 + (s[1] == ' '));
+            else
+            {
+                if (t->names[0] != '\0')
+                    fprintf(meta, "%s\n", t->names + (t->names[0] == ' '));
+                snprintf(t->names, sizeof(t->names), "%s", s + 1);
+            }
+            continue;
+        }
+        if (*s == '\0')
+        {
+            empty = 1;
+            continue;
+        }
+        while (*s != '\0')
+        {
+            char *end;
+            double x = strtod(s, &end);
+
+            if (end == s || c == MAX_COLUMNS)
+            {
+                free(line);
+                fclose(meta);
+                return -1;
+            }
+            if (t->n == t->size)
+            {
+                double *p = realloc(t->x, 2 * (t->size + 512) * sizeof(double));
+                if (p == NULL)
+                {
+                    free(line);
+                    fclose(meta);
+                    return -1;
+                }
+                t->x = p;
+                t->size = 2 * (t->size + 512);
+            }
+            t->x[t->n++] = x;
+            c++;
+            s = end + strspn(end, " \t\r\n,");
+        }
+        if (t->columns == 0)
+            t->columns = c;
+        if (c != t->columns)
+        {
+            free(line);
+            fclose(meta);
+            return -1;
+        }
+        if (empty)
+        { // a new block
+            long *b = realloc(t->block, (t->blocks + 1) * sizeof(long));
+            if (b == NULL)
+            {
+                free(line);
+                fclose(meta);
+                return -1;
+            }
+            t->block = b;
+            t->block[t->blocks++] = t->n / c - 1;
+            empty = 0;
+        }
+    }
+    free(line);
+    return fclose(meta);
+}
+
+static int ToBinary(const char *in, const char *out)
+{
+    /* -------------------------------------------------------------------------- *
+     * write the text file in as a result file                                    *
+     * -------------------------------------------------------------------------- */
+    text t;
+    FILE *f = fopen(in, "r");
+    int columns, error;
+    long rows;
+    char name[MAX_COLUMNS][32];
+    const char *names[MAX_COLUMNS];
+    results *r;
+
+    memset(&t, 0, sizeof(t));
+    if (f == NULL || Read(&t, f) != 0 || t.columns == 0)
+    {
+        printf("Error: cannot read the columns of '%s'\n", in);
+        return 1;
+    }
+    fclose(f);
+    rows = t.n / t.columns;
+    columns = (t.columns == 1 && t.blocks > 1) ? (int)t.blocks : t.columns;
+    if (columns > MAX_COLUMNS)
+    {
+        printf("Error: more than %d blocks in '%s'\n", MAX_COLUMNS, in);
+        return 1;
+    }
+
+    for (int c = 0; c < columns; c++)
+    {
+        snprintf(name[c], sizeof(name[c]), (columns > t.columns) ? "run_%d" :
+                 "c%d", c + 1);
+        names[c] = name[c];
+    }
+    if (columns == t.columns)
+    { // names from the last comment line, if it has one for each column
+        char line[sizeof(t.names)], *save, *word;
+        int c = 0;
+
+        strcpy(line, t.names);
+        word = strtok_r(line, " \t", &save);
+
+        while (word != NULL && c < columns)
+        {
+            snprintf(name[c++], sizeof(name[0]), "%s", word);
+            word = strtok_r(NULL, " \t", &save);
+        }
+        if (c != columns || word != NULL)
+            for (c = 0; c < columns; c++)
+                snprintf(name[c], sizeof(name[c]), "c%d", c + 1);
+        else
+            t.names[0] = '\0';
+    }
+    if (t.names[0] != '\0')
+    { // not the names: it is metadata as the other comment lines
+        char *m = realloc(t.meta, t.length + strlen(t.names) + 2);
+
+        if (m == NULL)
+            return 1;
+        t.meta = m;
+        t.length += sprintf(m + t.length, "%s\n", t.names + (t.names[0] == ' '));
+    }
+
+    if ((r = CreateResults(out, columns, names, t.meta)) == NULL)
+        return 1;
+    error = 0;
+    for (long i = 0; i < rows && !error; i++)
+    {
+        if (columns > t.columns)
+        { // one column per block
+            long b = 0;
+
+            while (b + 1 < t.blocks && t.block[b + 1] <= i)
+                b++;
+            error = PutResult(r, i - t.block[b], (int)b, t.x[i]);
+        }
+        else
+            for (int c = 0; c < columns && !error; c++)
+                error = PutResult(r, i, c, t.x[i * columns + c]);
+    }
+    if (SaveResults(r) != 0 || error)
+    {
+        printf("Error: cannot write '%s'\n", out);
+        return 1;
+    }
+    free(t.x);
+    free(t.block);
+    free(t.meta);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 4 && strcmp(argv[1], "-b") == 0)
+        return ToBinary(argv[2], argv[3]);
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "-f") == 0)
+        return ToText(argv[2], (argc == 4) ? argv[3] : NULL, "%f");
+    if (argc == 2 || (argc == 3 && argv[1][0] != '-'))
+        return ToText(argv[1], (argc == 3) ? argv[2] : NULL, "%.17g");
+    printf("Usage: convert.o [-f] file.res [file.txt]\n"
+           "       convert.o -b file.txt file.res\n");
+    return 1;
+}
@@ -1,54 +1,516 @@
-/* ----------------------------------------------------------------------
- * This program reads a data sample from a text file in the format
- *                         one data point per line 
- * and calculates an interval estimate for the mean of that (unknown) much 
- * larger set of data from which this sample was drawn.  The data can be 
- * either discrete or continuous.  A compiled version of this program 
- * supports redirection and can used just like program uvs.c. 
- * 
- * Name              : estimate.c  (Interval Estimation) 
- * Author            : Steve Park & Dave Geyer 
- * Language          : ANSI C 
- * Latest Revision   : 11-16-98 
- * ----------------------------------------------------------------------
- */
+/* -------------------------------------------------------------------------- *
+ * This program reads data samples from text files, one data point per line  *
+ * or several columns of data points per line, and calculates an interval     *
+ * estimate for the mean of each column, as the program of S. Park and        *
+ * D. Geyer that it replaces, but for millions of data points:                *
+ *                                                                            *
+ *   - the files are mapped in memory (stdin, if there are none, is read in   *
+ *     memory) and cut in chunks of CHUNK bytes at the end of a line,         *
+ *     processed in parallel by the threads of replicate.c;                   *
+ *   - the numbers are parsed without strtod() when they have at most 19      *
+ *     digits and the exact conversion is a single product or quotient by a   *
+ *     power of ten (W. D. Clinger, PLDI 1990), with strtod() otherwise;      *
+ *   - every chunk computes its mean and sum of squared deviations with       *
+ *     Welford's one-pass method, and the chunks are merged with the formula  *
+ *     of T. F. Chan, G. H. Golub and R. J. LeVeque (1979), in the order of   *
+ *     the chunks; the chunks depend only on the size of the file, so the     *
+ *     results do not depend on the number of threads;                        *
+ *   - the intervals are printed for several levels of confidence at once.    *
+ *                                                                            *
+ * Empty lines and lines starting with # (the comments of simulate) are      *
+ * skipped. The binary result files of simulate (see results.c) are read in   *
+ * place, by rows, without parsing, and their missing values are skipped.     *
+ * With a single file, column and level the output is in the layout of the    *
+ * original program. It is the same within rounding: for a file of a single   *
+ * chunk the numbers are exactly those of the original, while the merge of    *
+ * several chunks adds in another order and the last printed digit may        *
+ * differ.                                                                    *
+ *                                                                            *
+ * Usage: estimate.o [-l 0.90,0.95,0.99] [-t threads] [file ...]              *
+ *                                                                            *
+ * Name            : estimate.c  (Interval Estimation)                        *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
 
 #include <math.h>
 #include <stdio.h>
-#include "rvms.h"
-
-#define LOC 0.95                       /* level of confidence,        */ 
-                                       /* use 0.95 for 95% confidence */
-
-  int main(void)
-{
-  long   n    = 0;                     /* counts data points */
-  double sum  = 0.0;
-  double mean = 0.0;
-  double data;
-  double stdev;
-  double u, t, w;
-  double diff;
-
-  while (!feof(stdin)) {                 /* use Welford's one-pass method */
-    scanf("%lf\n", &data);               /* to calculate the sample mean  */
-    n++;                                 /* and standard deviation        */
-    diff  = data - mean;
-    sum  += diff * diff * (n - 1.0) / n;
-    mean += diff / n;
-  }
-  stdev  = sqrt(sum / n);
-
-  if (n > 1) {
-    u = 1.0 - 0.5 * (1.0 - LOC);              /* interval parameter  */
-    t = idfStudent(n - 1, u);                 /* critical value of t */
-    w = t * stdev / sqrt(n - 1);              /* interval half width */
-    printf("\nbased upon %ld data points", n);
-    printf(" and with %d%% confidence\n", (int) (100.0 * LOC + 0.5));
-    printf("the expected value is in the interval");
-    printf("%10.6f +/- %6.6f\n", mean, w);
-  }
-  else
-    printf("ERROR - insufficient data\n");
-  return (0);
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rvms.h"      // Student quantiles
+#include "replicate.h" // parallel tasks
+#include "results.h"   // binary result files
+
+#define LOC 0.95         /* default level of confidence            */
+#define MAX_LEVELS 16    /* levels of confidence                   */
+#define MAX_COLUMNS 256  /* columns of a file                      */
+#define CHUNK (1L << 18) /* bytes of a chunk, at least             */
+
+// Welford partial sums of a column
+typedef struct
+{
+    long n;      // data points
+    double mean; // their mean
+    double sum;  // sum of squared deviations from the mean
+} partial;
+
+// A file in memory
+typedef struct
+{
+    const char *name;
+    const char *data;
+    size_t size;
+    int mapped;   // 1 if data is mapped, 0 if allocated
+    int binary;   // 1 for a result file (see results.c), 0 for text
+    result_file res;
+    long first;   // first chunk of the file
+    long chunks;  // chunks of the file
+} input;
+
+// The chunks of all the files, processed as tasks
+typedef struct
+{
+    input *file;
+    int files;
+    const char **begin; // bytes of each chunk
+    const char **end;
+    long *row;          // or rows of each chunk, row[2k] to row[2k + 1] - 1
+    int *owner;         // file of each chunk
+    partial *part;      // MAX_COLUMNS per chunk
+    int *columns;       // columns of each chunk
+    int error;          // a line with too many columns
+} job;
+
+static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                               1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                               1e18, 1e19, 1e20, 1e21, 1e22};
+
+static const char *Number(const char *s, const char *end, double *x)
+{
+    /* -------------------------------------------------------------------------- *
+     * parse the number at s (before end) into x, return the first byte after it, *
+     * or s if there is no number                                                 *
+     * -------------------------------------------------------------------------- */
+    const char *p = s;
+    unsigned long long m = 0;
+    int digits = 0, exponent = 0, negative = 0, seen = 0;
+
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+    for (; p < end && *p == '0'; p++) // leading zeros are not digits of m
+        seen = 1;
+    for (; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+        m = 10 * m + (*p - '0');
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+        {
+            m = 10 * m + (*p - '0');
+            exponent--;
+        }
+    }
+    if (!seen && digits == 0)
+        return s;
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char *q = p + 1;
+        int sign = 1, e = 0;
+
+        if (q < end && (*q == '-' || *q == '+'))
+            sign = (*q++ == '-') ? -1 : 1;
+        if (q < end && *q >= '0' && *q <= '9')
+        {
+            for (; q < end && *q >= '0' && *q <= '9'; q++)
+                e = (e < 10000) ? 10 * e + (*q - '0') : e;
+            exponent += sign * e;
+            p = q;
+        }
+    }
+
+    if (digits <= 19 && m <= (1ULL << 53) && exponent >= -22 && exponent <= 22)
+    { // m and 10^|exponent| are exact doubles: one rounding only
+        *x = (exponent < 0) ? (double)m / pow10[-exponent]
+                            : (double)m * pow10[exponent];
+        if (negative)
+            *x = -*x;
+    }
+    else
+    { // the slow path, on a copy ended by '\0'
+        char buffer[128];
+        size_t n = p - s;
+
+        if (n >= sizeof(buffer))
+            n = sizeof(buffer) - 1;
+        memcpy(buffer, s, n);
+        buffer[n] = '\0';
+        *x = strtod(buffer, NULL);
+    }
+    return p;
+}
+
+static void Add(partial *a, double x)
+{
+    double diff = x - a->mean;
+
+    a->n++;
+    a->sum += diff * diff * (a->n - 1.0) / a->n;
+    a->mean += diff / a->n;
+}
+
+static void Merge(partial *a, const partial *b)
+{
+    /* -------------------------------------------------------------------------- *
+     * a becomes the partial sums of the data of a and b together (Chan et al.)   *
+     * -------------------------------------------------------------------------- */
+    long n = a->n + b->n;
+    double delta = b->mean - a->mean;
+
+    if (b->n == 0)
+        return;
+    if (a->n == 0)
+    {
+        *a = *b;
+        return;
+    }
+    a->mean += delta * b->n / n;
+    a->sum += b->sum + delta * delta * ((double)a->n * b->n / n);
+    a->n = n;
+}
+
+static void Chunk(long k, int worker, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * the partial sums of the columns of chunk k                                 *
+     * -------------------------------------------------------------------------- */
+    job *j = arg;
+    partial *part = j->part + k * MAX_COLUMNS;
+    const char *s = j->begin[k];
+    const char *end = j->end[k];
+    const input *in = &j->file[j->owner[k]];
+    int columns = 0;
+
+    if (in->binary)
+    { // the columns are read in place, the missing values are NAN
+        columns = (in->res.columns < MAX_COLUMNS) ? in->res.columns
+                                                  : MAX_COLUMNS;
+        for (int c = 0; c < columns; c++)
+        {
+            const double *x = ResultColumn(&in->res, c);
+
+            for (long r = j->row[2 * k]; r < j->row[2 * k + 1]; r++)
+                if (!isnan(x[r]))
+                    Add(&part[c], x[r]);
+        }
+        j->columns[k] = columns;
+        return;
+    }
+
+    while (s < end)
+    {
+        const char *eol = memchr(s, '\n', end - s);
+        int c = 0;
+
+        if (eol == NULL)
+            eol = end;
+        while (s < eol && (*s == ' ' || *s == '\t' || *s == '\r'))
+            s++;
+        if (s < eol && *s != '#')
+        {
+            while (s < eol)
+            {
+                double x;
+                const char *next = Number(s, eol, &x);
+
+                if (next == s) // not a number: skip the word
+                    while (s < eol && *s != ' ' && *s != '\t' && *s != '\r')
+                        s++;
+                else if (c == MAX_COLUMNS)
+                {
+                    j->error = 1;
+                    break;
+                }
+                else
+                {
+                    Add(&part[c++], x);
+                    s = next;
+                }
+                while (s < eol && (*s == ' ' || *s == '\t' || *s == '\r' ||
+                                   *s == ','))
+                    s++;
+            }
+        }
+        if (c > columns)
+            columns = c;
+        s = eol + 1;
+    }
+    j->columns[k] = columns;
+}
+
+static int Open(input *f, const char *name)
+{
+    /* -------------------------------------------------------------------------- *
+     * map the file name in memory, or read stdin if name is NULL                 *
+     * -------------------------------------------------------------------------- */
+    struct stat st;
+    int fd;
+
+    f->name = (name != NULL) ? name : "stdin";
+    f->data = NULL;
+    f->size = 0;
+    f->mapped = 0;
+    if (name == NULL)
+    {
+        size_t size = 0;
+        char *data = NULL;
+
+        for (;;)
+        {
+            char *d = realloc(data, size + CHUNK);
+            size_t n;
+
+            if (d == NULL)
+            {
+                free(data);
+                return -1;
+            }
+            data = d;
+            if ((n = fread(data + size, 1, CHUNK, stdin)) == 0)
+                break;
+            size += n;
+        }
+        f->data = data;
+        f->size = size;
+        return 0;
+    }
+    if ((fd = open(name, O_RDONLY)) < 0 || fstat(fd, &st) != 0)
+    {
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+    f->size = st.st_size;
+    if (f->size > 0)
+    {
+        void *p = mmap(NULL, f->size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (p == MAP_FAILED)
+        {
+            close(fd);
+            return -1;
+        }
+        madvise(p, f->size, MADV_SEQUENTIAL);
+        f->data = p;
+        f->mapped = 1;
+    }
+    close(fd);
+    if (IsResults(f->data, f->size))
+    {
+        if (ViewResults(&f->res, f->data, f->size) != 0)
+            return -1;
+        f->binary = 1;
+    }
+    return 0;
+}
+
+static void Close(input *f)
+{
+    if (f->binary)
+        free(f->res.name);
+    if (f->mapped)
+        munmap((void *)f->data, f->size);
+    else
+        free((void *)f->data);
+}
+
+static int Levels(const char *s, double *loc)
+{
+    /* -------------------------------------------------------------------------- *
+     * the levels of confidence of a list as 0.90,0.95,0.99, -1 if not valid      *
+     * -------------------------------------------------------------------------- */
+    int n = 0;
+
+    while (*s != '\0')
+    {
+        char *end;
+        double x = strtod(s, &end);
+
+        if (end == s || n == MAX_LEVELS || x <= 0.0 || x >= 1.0)
+            return -1;
+        loc[n++] = x;
+        s = (*end == ',') ? end + 1 : end;
+        if (*end != ',' && *end != '\0')
+            return -1;
+    }
+    return n;
+}
+
+static double HalfWidth(const partial *a, double loc)
+{
+    double u = 1.0 - 0.5 * (1.0 - loc);    /* interval parameter  */
+    double t = idfStudent(a->n - 1, u);    /* critical value of t */
+    return t * sqrt(a->sum / a->n) / sqrt(a->n - 1);
+}
+
+int main(int argc, char *argv[])
+{
+    double loc[MAX_LEVELS] = {LOC};
+    int levels = 1;
+    int threads = DefaultThreads();
+    long chunks = 0;
+    job j;
+    int a, k;
+
+    for (a = 1; a < argc && argv[a][0] == '-' && argv[a][1] != '\0'; a += 2)
+    {
+        if (a + 1 == argc ||
+            (strcmp(argv[a], "-l") == 0 &&
+             (levels = Levels(argv[a + 1], loc)) < 1) ||
+            (strcmp(argv[a], "-t") == 0 && (threads = atoi(argv[a + 1])) < 1) ||
+            (strcmp(argv[a], "-l") != 0 && strcmp(argv[a], "-t") != 0))
+        {
+            printf("Usage: estimate.o [-l 0.90,0.95,0.99] [-t threads] "
+                   "[file ...]\n");
+            return 1;
+        }
+    }
+
+    memset(&j, 0, sizeof(j));
+    j.files = (a < argc) ? argc - a : 1;
+    j.file = calloc(j.files, sizeof(input));
+    if (j.file == NULL)
+        return 1;
+    for (int f = 0; f < j.files; f++)
+    {
+        input *in = &j.file[f];
+
+        if (Open(in, (a < argc) ? argv[a + f] : NULL) != 0)
+        {
+            printf("ERROR - cannot read %s\n", (a < argc) ? argv[a + f] : "stdin");
+            return 1;
+        }
+        in->first = chunks;
+        in->chunks = 1 + in->size / CHUNK; // the same for any threads
+        if (in->binary && in->chunks > in->res.rows)
+            in->chunks = (in->res.rows > 0) ? in->res.rows : 1;
+        chunks += in->chunks;
+    }
+
+    j.begin = malloc(chunks * sizeof(const char *));
+    j.end = malloc(chunks * sizeof(const char *));
+    j.row = malloc(2 * chunks * sizeof(long));
+    j.owner = malloc(chunks * sizeof(int));
+    j.part = calloc(chunks * MAX_COLUMNS, sizeof(partial));
+    j.columns = calloc(chunks, sizeof(int));
+    if (j.begin == NULL || j.end == NULL || j.row == NULL || j.owner == NULL ||
+        j.part == NULL || j.columns == NULL)
+    {
+        printf("ERROR - out of memory\n");
+        return 1;
+    }
+    for (int f = 0; f < j.files; f++)
+    { // chunks of equal size, moved to the end of a line
+        input *in = &j.file[f];
+        const char *s = in->data;
+        const char *end = in->data + in->size;
+
+        for (long c = 0; c < in->chunks; c++)
+        {
+            const char *e = in->data + (in->size * (c + 1)) / in->chunks;
+
+            j.owner[in->first + c] = f;
+            if (in->binary)
+            { // rows of equal number
+                j.row[2 * (in->first + c)] = in->res.rows * c / in->chunks;
+                j.row[2 * (in->first + c) + 1] =
+                    in->res.rows * (c + 1) / in->chunks;
+                continue;
+            }
+
+            if (e < s)
+                e = s;
+            if (e < end && (e = memchr(e, '\n', end - e)) == NULL)
+                e = end;
+            j.begin[in->first + c] = s;
+            j.end[in->first + c] = e;
+            s = (e < end) ? e + 1 : end;
+        }
+    }
+
+    if (RunTasks(chunks, threads, Chunk, &j) != 0)
+    {
+        printf("ERROR - cannot start the threads\n");
+        return 1;
+    }
+    if (j.error)
+        printf("WARNING - columns after the %d-th are ignored\n", MAX_COLUMNS);
+
+    for (int f = 0; f < j.files; f++)
+    {
+        input *in = &j.file[f];
+        partial *total = j.part + in->first * MAX_COLUMNS;
+        int columns = 0;
+
+        for (long c = in->first; c < in->first + in->chunks; c++)
+        { // merged in order, into the first chunk
+            if (j.columns[c] > columns)
+                columns = j.columns[c];
+            for (k = 0; c > in->first && k < j.columns[c]; k++)
+                Merge(&total[k], &j.part[c * MAX_COLUMNS + k]);
+        }
+
+        if (j.files == 1 && columns == 1 && levels == 1)
+        { // the output of the original program
+            if (total[0].n > 1)
+            {
+                printf("\nbased upon %ld data points", total[0].n);
+                printf(" and with %d%% confidence\n", (int)(100.0 * loc[0] + 0.5));
+                printf("the expected value is in the interval");
+                printf("%10.6f +/- %6.6f\n", total[0].mean,
+                       HalfWidth(&total[0], loc[0]));
+            }
+            else
+                printf("ERROR - insufficient data\n");
+            continue;
+        }
+
+        if (f == 0)
+        {
+            printf("# file column n mean stdev");
+            for (int l = 0; l < levels; l++)
+                printf(" +/-%g%%", 100.0 * loc[l]);
+            printf("\n");
+        }
+        for (k = 0; k < columns; k++)
+        {
+            if (in->binary)
+                printf("%s %s", in->name, in->res.name[k]);
+            else
+                printf("%s %d", in->name, k + 1);
+            printf(" %ld %.9g %.9g", total[k].n, total[k].mean,
+                   (total[k].n > 0) ? sqrt(total[k].sum / total[k].n) : 0.0);
+            for (int l = 0; l < levels; l++)
+                printf(" %.6g", (total[k].n > 1) ? HalfWidth(&total[k], loc[l])
+                                                : 0.0);
+            printf("\n");
+        }
+        if (columns == 0)
+            printf("%s - ERROR - insufficient data\n", in->name);
+    }
+
+    for (int f = 0; f < j.files; f++)
+        Close(&j.file[f]);
+    free(j.file);
+    free(j.begin);
+    free(j.end);
+    free(j.row);
+    free(j.owner);
+    free(j.part);
+    free(j.columns);
+    return (0);
 }
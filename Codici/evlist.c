@@ -0,0 +1,506 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library for the management of the event list of a next-event    *
+ * simulation. Every event type has a fixed index 0, 1, ..., size - 1 (the    *
+ * arrival process and one departure process per service node), and at most  *
+ * one pending event per index. The list returns the most imminent active     *
+ * event; ties are broken in favour of the lowest index, as the original      *
+ * linear NextEvent() did, so every implementation produces the same          *
+ * sequence of events.                                                        *
+ *                                                                            *
+ * Four implementations share the same interface:                             *
+ *   EVENT_LINEAR   : O(N) scan of all the event types                        *
+ *   EVENT_HEAP     : indexed binary heap, O(log N) schedule/cancel           *
+ *   EVENT_DHEAP    : indexed 4-ary heap, shallower and more cache friendly   *
+ *   EVENT_CALENDAR : calendar queue, O(1) expected time per operation        *
+ *                                                                            *
+ * ScheduleEvent() on an index that is already active changes its time        *
+ * (decrease-key or increase-key), CancelEvent() turns it off. The time of a  *
+ * cancelled event is kept and can still be read with EventTime().            *
+ *                                                                            *
+ * Name            : evlist.c  (Event List Management)                        *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "evlist.h"
+
+#define MIN_BUCKETS 2  /* smallest calendar                    */
+#define SAMPLE 25      /* events sampled to size the buckets   */
+
+typedef struct
+{
+    int (*schedule)(event_list *list, int index, double t);
+    void (*cancel)(event_list *list, int index);
+    int (*next)(event_list *list);
+} event_ops;
+
+struct event_list
+{
+    int kind;
+    int size;   // number of event types
+    int count;  // number of active events
+    double *t;  // next event time
+    char *x;    // status: 0 (off) or 1 (on)
+    const event_ops *ops;
+
+    // heaps
+    int d;     // arity of the heap
+    int *heap; // event indexes in heap order
+    int *pos;  // position of each event in the heap
+
+    // calendar queue
+    int buckets;   // number of buckets (a power of 2)
+    double width;  // time width of a bucket
+    int *head;     // first event of each bucket
+    int *link;     // next event in the same bucket
+    int *back;     // previous event in the same bucket
+    long slot;     // day of the calendar reached so far
+    int cached;    // most imminent event, -1 if unknown
+    double *tmp;   // scratch area used when resizing
+};
+
+static int Before(const event_list *list, int a, int b)
+{
+    /* -------------------------------------------------------------------------- *
+     * return 1 if event a comes before event b (ties go to the lowest index)     *
+     * -------------------------------------------------------------------------- */
+    return (list->t[a] < list->t[b]) || (list->t[a] == list->t[b] && a < b);
+}
+
+/* ------------------------------- Linear scan ------------------------------ */
+
+static int LinearSchedule(event_list *list, int index, double t)
+{
+    list->count += !list->x[index];
+    list->t[index] = t;
+    list->x[index] = 1;
+    return 0;
+}
+
+static void LinearCancel(event_list *list, int index)
+{
+    list->count -= list->x[index];
+    list->x[index] = 0;
+}
+
+static int LinearNext(event_list *list)
+{
+    int e = -1;
+
+    for (int i = 0; i < list->size; i++)
+    {
+        if (list->x[i] && (e < 0 || list->t[i] < list->t[e]))
+            e = i;
+    }
+    return (e);
+}
+
+/* ------------------------------- d-ary heaps ------------------------------ */
+
+static void SiftUp(event_list *list, int p)
+{
+    int e = list->heap[p];
+
+    while (p > 0)
+    {
+        int parent = (p - 1) / list->d;
+        if (!Before(list, e, list->heap[parent]))
+            break;
+        list->heap[p] = list->heap[parent];
+        list->pos[list->heap[p]] = p;
+        p = parent;
+    }
+    list->heap[p] = e;
+    list->pos[e] = p;
+}
+
+static void SiftDown(event_list *list, int p)
+{
+    int e = list->heap[p];
+
+    for (;;)
+    {
+        int first = p * list->d + 1;
+        int last = first + list->d;
+        int c = first;
+
+        if (first >= list->count)
+            break;
+        if (last > list->count)
+            last = list->count;
+        for (int i = first + 1; i < last; i++)
+        {
+            if (Before(list, list->heap[i], list->heap[c]))
+                c = i;
+        }
+        if (!Before(list, list->heap[c], e))
+            break;
+        list->heap[p] = list->heap[c];
+        list->pos[list->heap[p]] = p;
+        p = c;
+    }
+    list->heap[p] = e;
+    list->pos[e] = p;
+}
+
+static int HeapSchedule(event_list *list, int index, double t)
+{
+    if (list->x[index])
+    { // change the key of a pending event
+        int p = list->pos[index];
+        double old = list->t[index];
+
+        list->t[index] = t;
+        if (t < old)
+            SiftUp(list, p);
+        else
+            SiftDown(list, p);
+    }
+    else
+    {
+        list->t[index] = t;
+        list->x[index] = 1;
+        list->heap[list->count] = index;
+        SiftUp(list, list->count++);
+    }
+    return 0;
+}
+
+static void HeapCancel(event_list *list, int index)
+{
+    int p, e;
+
+    if (!list->x[index])
+        return;
+    list->x[index] = 0;
+    p = list->pos[index];
+    e = list->heap[--list->count];
+    if (p == list->count)
+        return;
+    list->heap[p] = e;
+    list->pos[e] = p;
+    if (p > 0 && Before(list, e, list->heap[(p - 1) / list->d]))
+        SiftUp(list, p);
+    else
+        SiftDown(list, p);
+}
+
+static int HeapNext(event_list *list)
+{
+    return (list->count > 0) ? list->heap[0] : -1;
+}
+
+/* ----------------------------- Calendar queue ----------------------------- */
+
+static long Day(const event_list *list, double t)
+{
+    return (long)(t / list->width);
+}
+
+static void BucketInsert(event_list *list, int index)
+{
+    /* -------------------------------------------------------------------------- *
+     * insert an event in its bucket, keeping the bucket sorted                   *
+     * -------------------------------------------------------------------------- */
+    int b = (int)(Day(list, list->t[index]) & (list->buckets - 1));
+    int prev = -1;
+    int i = list->head[b];
+
+    while (i >= 0 && Before(list, i, index))
+    {
+        prev = i;
+        i = list->link[i];
+    }
+    list->link[index] = i;
+    list->back[index] = prev;
+    if (i >= 0)
+        list->back[i] = index;
+    if (prev >= 0)
+        list->link[prev] = index;
+    else
+        list->head[b] = index;
+}
+
+static void BucketRemove(event_list *list, int index)
+{
+    int b = (int)(Day(list, list->t[index]) & (list->buckets - 1));
+
+    if (list->back[index] >= 0)
+        list->link[list->back[index]] = list->link[index];
+    else
+        list->head[b] = list->link[index];
+    if (list->link[index] >= 0)
+        list->back[list->link[index]] = list->back[index];
+}
+
+static int CompareTimes(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static int Resize(event_list *list, int buckets)
+{
+    /* -------------------------------------------------------------------------- *
+     * change the number of buckets, and estimate a new bucket width as three     *
+     * times the average separation of the most imminent events; return -1 if     *
+     * out of memory, with the old buckets and width left as they were            *
+     * -------------------------------------------------------------------------- */
+    int *head = malloc(buckets * sizeof(int));
+    int n = 0;
+
+    if (head == NULL)
+        return -1;
+    for (int i = 0; i < list->size; i++)
+    {
+        if (list->x[i])
+            list->tmp[n++] = list->t[i];
+    }
+    if (n > 1)
+    {
+        int k = (n < SAMPLE) ? n : SAMPLE;
+        double gap;
+
+        qsort(list->tmp, n, sizeof(double), CompareTimes);
+        gap = (list->tmp[k - 1] - list->tmp[0]) / (k - 1);
+        if (gap > 0.0)
+            list->width = 3.0 * gap;
+    }
+
+    free(list->head);
+    list->buckets = buckets;
+    list->head = head;
+    for (int b = 0; b < buckets; b++)
+        list->head[b] = -1;
+    list->slot = (n > 0) ? Day(list, list->tmp[0]) : 0;
+    for (int i = 0; i < list->size; i++)
+    {
+        if (list->x[i])
+            BucketInsert(list, i);
+    }
+    list->cached = -1;
+    return 0;
+}
+
+static int CalendarSchedule(event_list *list, int index, double t)
+{
+    if (list->x[index])
+    {
+        BucketRemove(list, index);
+        if (list->cached == index)
+            list->cached = -1;
+    }
+    else
+    {
+        list->x[index] = 1;
+        list->count++;
+    }
+    list->t[index] = t;
+    BucketInsert(list, index);
+
+    if (Day(list, t) < list->slot)
+        list->slot = Day(list, t);
+    if (list->cached >= 0 && Before(list, index, list->cached))
+        list->cached = index;
+
+    if (list->count > 2 * list->buckets)
+        return Resize(list, 2 * list->buckets);
+    return 0;
+}
+
+static void CalendarCancel(event_list *list, int index)
+{
+    if (!list->x[index])
+        return;
+    BucketRemove(list, index);
+    list->x[index] = 0;
+    list->count--;
+    if (list->cached == index)
+        list->cached = -1;
+
+    if (list->count < list->buckets / 2 && list->buckets > MIN_BUCKETS)
+        Resize(list, list->buckets / 2); // else it stays larger
+}
+
+static int CalendarNext(event_list *list)
+{
+    /* -------------------------------------------------------------------------- *
+     * scan the calendar one day at a time, starting from the day of the last     *
+     * minimum: the first bucket whose head falls on the current day holds the    *
+     * most imminent event. After a whole year without events, fall back to a     *
+     * direct search among the heads of the buckets.                              *
+     * -------------------------------------------------------------------------- */
+    int mask = list->buckets - 1;
+    int e = -1;
+
+    if (list->cached >= 0 || list->count == 0)
+        return (list->count > 0) ? list->cached : -1;
+
+    for (long day = list->slot; day < list->slot + list->buckets; day++)
+    {
+        int i = list->head[day & mask];
+        if (i >= 0 && Day(list, list->t[i]) <= day)
+        {
+            e = i;
+            break;
+        }
+    }
+    if (e < 0)
+    {
+        for (int b = 0; b < list->buckets; b++)
+        {
+            int i = list->head[b];
+            if (i >= 0 && (e < 0 || Before(list, i, e)))
+                e = i;
+        }
+    }
+    list->slot = Day(list, list->t[e]);
+    list->cached = e;
+    return (e);
+}
+
+static const event_ops linear_ops = {LinearSchedule, LinearCancel, LinearNext};
+static const event_ops heap_ops = {HeapSchedule, HeapCancel, HeapNext};
+static const event_ops calendar_ops = {CalendarSchedule, CalendarCancel,
+                                       CalendarNext};
+
+/* ------------------------------- Interface -------------------------------- */
+
+event_list *CreateEventList(int kind, int size)
+{
+    /* -------------------------------------------------------------------------- *
+     * allocate an empty event list for the event types 0, 1, ..., size - 1       *
+     * -------------------------------------------------------------------------- */
+    event_list *list = calloc(1, sizeof(event_list));
+
+    if (list == NULL)
+        return NULL;
+    list->kind = kind;
+    list->size = size;
+    list->t = calloc(size, sizeof(double));
+    list->x = calloc(size, sizeof(char));
+
+    switch (kind)
+    {
+    case EVENT_HEAP:
+    case EVENT_DHEAP:
+        list->ops = &heap_ops;
+        list->d = (kind == EVENT_HEAP) ? 2 : 4;
+        list->heap = malloc(size * sizeof(int));
+        list->pos = malloc(size * sizeof(int));
+        break;
+    case EVENT_CALENDAR:
+        list->ops = &calendar_ops;
+        list->width = 1.0;
+        list->link = malloc(size * sizeof(int));
+        list->back = malloc(size * sizeof(int));
+        list->tmp = malloc(size * sizeof(double));
+        if (list->t == NULL || list->x == NULL || list->link == NULL ||
+            list->back == NULL || list->tmp == NULL ||
+            Resize(list, MIN_BUCKETS) != 0)
+        {
+            FreeEventList(list);
+            return NULL;
+        }
+        break;
+    default:
+        list->kind = EVENT_LINEAR;
+        list->ops = &linear_ops;
+        break;
+    }
+    if (list->t == NULL || list->x == NULL ||
+        (list->d > 0 && (list->heap == NULL || list->pos == NULL)))
+    {
+        FreeEventList(list);
+        return NULL;
+    }
+    return (list);
+}
+
+void FreeEventList(event_list *list)
+{
+    if (list == NULL)
+        return;
+    free(list->t);
+    free(list->x);
+    free(list->heap);
+    free(list->pos);
+    free(list->head);
+    free(list->link);
+    free(list->back);
+    free(list->tmp);
+    free(list);
+}
+
+void ClearEvents(event_list *list)
+{
+    /* -------------------------------------------------------------------------- *
+     * turn off every event and reset all the event times to 0                    *
+     * -------------------------------------------------------------------------- */
+    for (int i = 0; i < list->size; i++)
+    {
+        list->t[i] = 0.0;
+        list->x[i] = 0;
+    }
+    list->count = 0;
+    if (list->kind == EVENT_CALENDAR)
+        Resize(list, MIN_BUCKETS); // else the buckets of before, all empty
+}
+
+int ScheduleEvent(event_list *list, int index, double t)
+{
+    /* -------------------------------------------------------------------------- *
+     * schedule event index at time t; return -1 if a calendar could not grow     *
+     * for lack of memory: the event is scheduled all the same, and the list      *
+     * stays valid, only with longer buckets                                      *
+     * -------------------------------------------------------------------------- */
+    return list->ops->schedule(list, index, t);
+}
+
+void CancelEvent(event_list *list, int index)
+{
+    list->ops->cancel(list, index);
+}
+
+int NextEvent(event_list *list)
+{
+    /* -------------------------------------------------------------------------- *
+     * return the index of the next event type, or -1 if no event is active      *
+     * -------------------------------------------------------------------------- */
+    return list->ops->next(list);
+}
+
+double EventTime(const event_list *list, int index)
+{
+    return (list->t[index]);
+}
+
+int EventActive(const event_list *list, int index)
+{
+    return (list->x[index]);
+}
+
+int EventCount(const event_list *list)
+{
+    return (list->count);
+}
+
+const char *EventListName(int kind)
+{
+    switch (kind)
+    {
+    case EVENT_HEAP:
+        return "binary heap";
+    case EVENT_DHEAP:
+        return "4-ary heap";
+    case EVENT_CALENDAR:
+        return "calendar";
+    default:
+        return "linear";
+    }
+}
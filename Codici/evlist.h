@@ -0,0 +1,31 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : evlist.h  (header file for the library evlist.c)         *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_EVLIST_)
+#define _EVLIST_
+
+#define EVENT_LINEAR 0   /* linear scan (the original NextEvent)    */
+#define EVENT_HEAP 1     /* binary heap with decrease-key           */
+#define EVENT_DHEAP 2    /* 4-ary heap with decrease-key            */
+#define EVENT_CALENDAR 3 /* calendar queue (R. Brown, CACM 1988)    */
+
+typedef struct event_list event_list;
+
+event_list *CreateEventList(int kind, int size);
+void FreeEventList(event_list *list);
+void ClearEvents(event_list *list);
+
+int ScheduleEvent(event_list *list, int index, double t);
+void CancelEvent(event_list *list, int index);
+int NextEvent(event_list *list);
+
+double EventTime(const event_list *list, int index);
+int EventActive(const event_list *list, int index);
+int EventCount(const event_list *list);
+const char *EventListName(int kind);
+
+#endif
@@ -0,0 +1,106 @@
+/* -------------------------------------------------------------------------- *
+ * This program writes a synthetic topology file (see topology.c) for large   *
+ * networks, built as the campus of nsssn_bp.c: APS access points, grouped in *
+ * blocks behind SWITCHES access switches, which send the jobs to the core    *
+ * switch; an arrival goes to an AP with weight 1 or, with weight 4 * APS,    *
+ * straight to the core. With SWITCHES 0 the APs are connected to the core,   *
+ * that is the file is exactly the model of nsssn_bp.c with APS APs.          *
+ * Then it loads the file back REPEAT times and prints the mean time of a     *
+ * load, to measure LoadTopology() on networks of thousands of nodes.         *
+ *                                                                            *
+ * Usage: gentopo.o [aps [switches [file]]]                                   *
+ *                                                                            *
+ * Name            : gentopo.c  (Synthetic Topology Generator)                *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "topology.h" /* network topology */
+
+#define APS 9900        /* access points                  */
+#define SWITCHES 99     /* access switches, 0 for none    */
+#define FILENAME "synthetic.top"
+#define ALPHA 0.5       /* shape parameter of BP Distribution */
+#define AP_MIN 0.3756009615
+#define AP_MAX 8.756197416
+#define SW_MIN 0.002709302035
+#define SW_MAX 0.0631606037
+#define REPEAT 20
+
+static double Now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static int Write(const char *path, long aps, long switches)
+{
+    /* -------------------------------------------------------------------------- *
+     * write the topology file, return -1 if it cannot be written                 *
+     * -------------------------------------------------------------------------- */
+    const char *core = (switches > 0) ? "Core" : "Sw";
+    FILE *f = fopen(path, "w");
+
+    if (f == NULL)
+        return -1;
+    fprintf(f, "# synthetic campus: %ld APs, %ld access switches\n", aps,
+            switches);
+    fprintf(f, "group AP %ld bp %g %.10g %.10g\n", aps, ALPHA, AP_MIN, AP_MAX);
+    if (switches > 0)
+        fprintf(f, "group Acc %ld bp %g %.10g %.10g\n", switches, ALPHA,
+                SW_MIN, SW_MAX);
+    fprintf(f, "group %s 1 bp %g %.10g %.10g\n", core, ALPHA, SW_MIN, SW_MAX);
+    fprintf(f, "route source AP 1\n");
+    fprintf(f, "route source %s %ld\n", core, 4 * aps);
+    if (switches > 0)
+    {
+        fprintf(f, "route AP Acc 1 block\n");
+        fprintf(f, "route Acc %s 1\n", core);
+    }
+    else
+        fprintf(f, "route AP %s 1\n", core);
+    fprintf(f, "route %s exit 1\n", core);
+    return fclose(f);
+}
+
+int main(int argc, char *argv[])
+{
+    long aps = (argc > 1) ? atol(argv[1]) : APS;
+    long switches = (argc > 2) ? atol(argv[2]) : SWITCHES;
+    const char *path = (argc > 3) ? argv[3] : FILENAME;
+    topology *t;
+    double start;
+
+    if (aps < 1 || switches < 0 || switches > aps)
+    {
+        printf("Usage: gentopo.o [aps [switches [file]]], 0 <= switches <= aps\n");
+        return 1;
+    }
+    if (Write(path, aps, switches) != 0)
+    {
+        printf("Error: cannot write '%s'\n", path);
+        return 1;
+    }
+
+    start = Now();
+    for (int i = 0; i < REPEAT; i++)
+    {
+        if ((t = LoadTopology(path)) == NULL)
+            return 1;
+        if (i + 1 < REPEAT)
+            FreeTopology(t);
+    }
+    printf("%s: %d nodes in %d groups, loaded in %.3f ms\n", path, t->nodes,
+           t->groups, 1e3 * (Now() - start) / REPEAT);
+    for (int g = 0; g < t->groups; g++)
+        printf("  %-4s %6d nodes from %6d, mean service %f\n", t->name[g],
+               t->count[g], t->first[g], DistMean(&t->service[g]));
+    FreeTopology(t);
+    return 0;
+}
@@ -0,0 +1,727 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library that simulates the network of netsim.c without events,   *
+ * when it is feed-forward in two levels as the campus: every node sends its  *
+ * jobs to a single node (or out of the network) and a node that receives     *
+ * jobs from other nodes sends them out. A FIFO single-server node is then    *
+ * completely described by the recursion of Lindley on its jobs, in order of  *
+ * arrival,                                                                   *
+ *                                                                            *
+ *   r[k] = s[k] + max(0, r[k-1] - (a[k] - a[k-1]))      (response time)      *
+ *   d[k] = a[k] + r[k]                                  (departure time)     *
+ *                                                                            *
+ * so RunLindley() draws all the arrival times and the routing at once, then  *
+ * runs the recursion on the jobs of each AP, merges the departures of the    *
+ * APs with the arrivals from outside into the input of the switch (merged    *
+ * two runs at a time), and runs the recursion on the switch. The service     *
+ * times are drawn BLOCK at a time with SampleFillR(), and the differences    *
+ * and the departures are separate loops on BLOCK jobs that the compiler      *
+ * vectorizes: only the max() of the recursion is sequential.                 *
+ *                                                                            *
+ * It is the same model as netsim.c with purge = 1, but the random numbers    *
+ * are consumed in another order (the routing from outside draws from its     *
+ * own stream, streams + groups), so the results are statistically the same   *
+ * and not equal: bench_lindley.c compares the two and measures the speedup.  *
+ * Finite queues, a limit of departures, purge = 0 and any other topology are *
+ * left to netsim.c (see LindleyNetwork()).                                   *
+ *                                                                            *
+ * The APs never interact with each other, so RunDecomposition() serves them  *
+ * on threads, each thread a share of the APs, a block at a time: the         *
+ * departures of each AP go through a lock-free ring (ring.c) to the thread   *
+ * of the switch, which merges the rings with the arrivals from outside as    *
+ * they come and serves a block as soon as it has one. The stream of the      *
+ * service times of each AP is jumped to the variate of its first job         *
+ * (JumpStream, see rngs.c), so every job gets the same service time of       *
+ * RunLindley() and the results are the same whatever the number of threads   *
+ * (this needs one random number per variate: Exponential or BoundedPareto).  *
+ * Its scaling has not been validated: it was only measured on one core,      *
+ * where the threads share it and it ran at 0.79-1.02x of RunLindley(), so    *
+ * it is not to be taken for a speedup until bench_lindley.c shows one on a   *
+ * machine with more cores; until then simulate does not offer it as an       *
+ * engine, and only bench_lindley.c runs it.                                  *
+ *                                                                            *
+ * Name            : lindley.c  (Lindley Recursion)                           *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include "rngs.h"      /* the multi-stream generator */
+#include "rvgs.h"      /* random variate generators  */
+#include "evlist.h"    /* event list management      */
+#include "ring.h"      /* rings between threads      */
+#include "replicate.h" /* pool of threads            */
+#include "netsim.h"
+#include "lindley.h"
+
+#define BLOCK 1024 /* jobs of a node in the recursion at a time */
+
+#define INLINE static inline __attribute__((always_inline))
+
+// Jobs of the network, by node
+typedef struct
+{
+    int *next;     // destination of each node, 0 for the exit, [1, nodes]
+    long *outside; // arrivals from outside of each node
+    long *jobs;    // all the jobs of each node
+    long *first;   // first job of each node in time
+    double *time;  // arrival, then departure, times of the jobs
+    long arrivals; // arrivals from outside up to STOP
+    double end;    // first arrival after STOP
+} network;
+
+// A node that serves its jobs BLOCK at a time
+typedef struct
+{
+    const rv_dist *d; // service time
+    rng_stream *r;    // stream of the service times
+    double *a;        // arrival, then departure, times of the jobs
+    long n;           // jobs
+    long done;        // jobs served
+    long sent;        // departures sent to the next node, by a thread
+    int closed;       // all of them sent
+    double last;      // arrival time of the last job served
+    double response;  // response time of the last job served
+    double area;      // sum of the response times
+    double service;   // sum of the service times
+} server;
+
+static int Destination(const sim_context *s, int i)
+{
+    /* -------------------------------------------------------------------------- *
+     * the only node where the jobs of node i go, 0 if they leave the network,    *
+     * -1 if they can go to more than one                                         *
+     * -------------------------------------------------------------------------- */
+    int k = Destinations(s->top->route, i);
+
+    if (k > 1)
+        return -1;
+    return (k == 1) ? Route(s->top->route, s->p.routing, i, NULL) : 0;
+}
+
+int LindleyNetwork(const sim_context *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * 1 if RunLindley() can simulate s: purge, no limit of departures, infinite  *
+     * queues, every job from outside enters a node, and feed-forward in two     *
+     * levels                                                                     *
+     * -------------------------------------------------------------------------- */
+    const topology *t = s->top;
+
+    if (s->p.purge != 1 || s->p.departures > 0 ||
+        s->p.streams + t->groups >= STREAMS ||
+        RouteProbability(t->route, 0, 0) > 0.0)
+        return 0;
+    for (int i = 1; i <= t->nodes; i++)
+    {
+        int j = Destination(s, i);
+
+        if (t->capacity[i] > 0 || j < 0 || (j > 0 && Destination(s, j) != 0))
+            return 0;
+    }
+    return 1;
+}
+
+static int Arrivals(sim_context *s, network *n, double **time, int **node)
+{
+    /* -------------------------------------------------------------------------- *
+     * the arrival times from outside up to STOP, the first one already drawn by  *
+     * InitSimulation(), with the node of each; return their number, -1 if out   *
+     * of memory (the arrays are freed by the caller in any case)                 *
+     * -------------------------------------------------------------------------- */
+    rng_stream *route = StreamR(&s->rng, s->p.streams + s->top->groups);
+    double x[BLOCK];
+    double t = s->arrival;
+    long count = 0, size = 0;
+    long k = BLOCK;
+
+    while (t <= s->p.stop)
+    {
+        if (count == size)
+        {
+            double *a = realloc(*time, 2 * (size + BLOCK) * sizeof(double));
+            int *b = (a != NULL) ?
+                     realloc(*node, 2 * (size + BLOCK) * sizeof(int)) : NULL;
+
+            if (a != NULL)
+                *time = a;
+            if (b == NULL)
+                return -1;
+            *node = b;
+            size = 2 * (size + BLOCK);
+        }
+        (*time)[count] = t;
+        (*node)[count] = Route(s->top->route, s->p.routing, 0, route);
+        n->outside[(*node)[count]]++;
+        count++;
+        if (k == BLOCK)
+        {
+            SampleFillR(&s->interarrival, s->in, x, BLOCK);
+            k = 0;
+        }
+        t += x[k++];
+    }
+    n->end = t;
+    return count;
+}
+
+INLINE void Block(double *restrict a, double *restrict r,
+                  const double *restrict service, long m, double *last,
+                  double *response, double *area)
+{
+    /* -------------------------------------------------------------------------- *
+     * the recursion on the m jobs of a: their arrival times become departure     *
+     * times; last is the arrival and response the response time of the job     *
+     * before                                                                     *
+     * -------------------------------------------------------------------------- */
+    double x = *response, sum = *area;
+
+    r[0] = a[0] - *last;
+    for (long k = 1; k < m; k++) // interarrival times
+        r[k] = a[k] - a[k - 1];
+    for (long k = 0; k < m; k++) // response times
+    {
+        double wait = x - r[k];
+
+        x = service[k] + (wait > 0.0 ? wait : 0.0);
+        r[k] = x;
+        sum += x;
+    }
+    *last = a[m - 1];
+    for (long k = 0; k < m; k++) // departure times
+        a[k] += r[k];
+    *response = x;
+    *area = sum;
+}
+
+static void Server(server *v, const sim_context *s, int i, rng_stream *r,
+                   network *n)
+{
+    /* -------------------------------------------------------------------------- *
+     * node i, with the service times from r, before its first job                *
+     * -------------------------------------------------------------------------- */
+    v->d = &s->top->service[s->top->group[i]];
+    v->r = r;
+    v->a = n->time + n->first[i];
+    v->n = n->jobs[i];
+    v->done = 0;
+    v->sent = 0;
+    v->closed = 0;
+    v->last = 0.0;
+    v->response = 0.0;
+    v->area = 0.0;
+    v->service = 0.0;
+}
+
+static long ServeBlock(server *v)
+{
+    /* -------------------------------------------------------------------------- *
+     * serve the next BLOCK jobs, or those left (whose arrival times must be      *
+     * known): their times become departure times; return how many                *
+     * -------------------------------------------------------------------------- */
+    double service[BLOCK], r[BLOCK];
+    long m = (v->n - v->done < BLOCK) ? v->n - v->done : BLOCK;
+    double *a = v->a + v->done;
+
+    if (v->done == 0 && m > 0)
+        v->last = a[0]; // the first job finds the node empty
+    SampleFillR(v->d, v->r, service, m);
+    for (long j = 0; j < m; j++)
+        v->service += service[j];
+    if (m == BLOCK) // with m constant, the loops are vectorized
+        Block(a, r, service, BLOCK, &v->last, &v->response, &v->area);
+    else if (m > 0)
+        Block(a, r, service, m, &v->last, &v->response, &v->area);
+    v->done += m;
+    return m;
+}
+
+static void Account(sim_context *s, int i, const server *v)
+{
+    s->statistics[i].service += v->service;
+    s->statistics[i].served += v->n;
+    s->area[i - 1] += v->area;
+}
+
+static void Merge2(const double *a, const double *b, const double *end,
+                   double *out)
+{
+    /* -------------------------------------------------------------------------- *
+     * merge the times in order a[0], ... up to b and b[0], ... up to end         *
+     * -------------------------------------------------------------------------- */
+    const double *mid = b;
+
+    while (a < mid && b < end)
+        *out++ = (*b < *a) ? *b++ : *a++;
+    while (a < mid)
+        *out++ = *a++;
+    while (b < end)
+        *out++ = *b++;
+}
+
+static int Merge(sim_context *s, network *n, int j)
+{
+    /* -------------------------------------------------------------------------- *
+     * the input of node j in order of time, from the arrivals from outside (at  *
+     * the end of its jobs) and the departures of the nodes that send it their    *
+     * jobs: the runs are merged two by two, about log2(runs) passes over the     *
+     * jobs; return -1 if out of memory                                           *
+     * -------------------------------------------------------------------------- */
+    long size = n->jobs[j];
+    double *out = n->time + n->first[j];
+    double *tmp = malloc(size * sizeof(double));
+    long *run = malloc((s->top->nodes + 2) * sizeof(long));
+    double *from = tmp, *to = out;
+    int runs = 0;
+    long at = 0;
+
+    if (tmp == NULL || run == NULL)
+    {
+        free(tmp);
+        free(run);
+        return -1;
+    }
+    for (int i = 1; i <= s->top->nodes; i++)
+    {
+        if (n->next[i] == j)
+        {
+            memcpy(tmp + at, n->time + n->first[i],
+                   n->jobs[i] * sizeof(double));
+            run[runs++] = at;
+            at += n->jobs[i];
+        }
+    }
+    memcpy(tmp + at, out + at, n->outside[j] * sizeof(double));
+    run[runs++] = at;
+    run[runs] = size;
+
+    while (runs > 1)
+    { // a pass: run 2k is merged with run 2k + 1
+        double *swap;
+        int k = 0;
+
+        for (int r = 0; r < runs; r += 2)
+        {
+            if (r + 1 < runs)
+                Merge2(from + run[r], from + run[r + 1], from + run[r + 2],
+                       to + run[r]);
+            else
+                memcpy(to + run[r], from + run[r],
+                       (run[r + 1] - run[r]) * sizeof(double));
+            run[k++] = run[r];
+        }
+        run[k] = size;
+        runs = k;
+        swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from != out)
+        memcpy(out, from, size * sizeof(double));
+    free(tmp);
+    free(run);
+    return 0;
+}
+
+static void Finish(sim_context *s, const network *n)
+{
+    /* -------------------------------------------------------------------------- *
+     * the state netsim.c leaves at the end of a run with purge: the network is   *
+     * empty at the last departure, and the arrival after STOP is cancelled       *
+     * -------------------------------------------------------------------------- */
+    for (int i = 1; i <= s->top->nodes; i++)
+    {
+        long last = n->first[i] + n->jobs[i] - 1;
+
+        if (n->jobs[i] > 0 && n->time[last] > s->current)
+            s->current = n->time[last];
+        if (n->next[i] == 0)
+            s->departures += n->jobs[i];
+    }
+    for (int i = 0; i < s->p.servers; i++)
+    {
+        s->number[i] = 0;
+        s->changed[i] = s->current;
+    }
+    s->arrivals += n->arrivals;
+    s->jobs = 0;
+    s->next = s->current;
+    s->arrival = n->end;
+    ClearEvents(s->event);
+    ScheduleEvent(s->event, 0, n->end);
+    CancelEvent(s->event, 0);
+}
+
+static void FreeNetwork(network *n)
+{
+    free(n->next);
+    free(n->outside);
+    free(n->jobs);
+    free(n->first);
+    free(n->time);
+}
+
+static int Jobs(sim_context *s, network *n)
+{
+    /* -------------------------------------------------------------------------- *
+     * the arrival times of the jobs of every node, those from outside after the  *
+     * others; return -1 if out of memory                                         *
+     * -------------------------------------------------------------------------- */
+    int nodes = s->top->nodes;
+    double *time = NULL;
+    int *node = NULL;
+    long total = 0;
+
+    n->next = calloc(nodes + 1, sizeof(int));
+    n->outside = calloc(nodes + 1, sizeof(long));
+    n->jobs = calloc(nodes + 1, sizeof(long));
+    n->first = calloc(nodes + 1, sizeof(long));
+    n->time = NULL;
+    n->arrivals = -1;
+    if (n->next != NULL && n->outside != NULL && n->jobs != NULL &&
+        n->first != NULL)
+        n->arrivals = Arrivals(s, n, &time, &node);
+
+    if (n->arrivals >= 0)
+    {
+        for (int i = 1; i <= nodes; i++)
+            n->next[i] = Destination(s, i);
+        for (int i = 1; i <= nodes; i++)
+        {
+            n->jobs[i] += n->outside[i];
+            if (n->next[i] > 0)
+                n->jobs[n->next[i]] += n->outside[i];
+        }
+        for (int i = 1; i <= nodes; i++)
+        {
+            n->first[i] = total;
+            total += n->jobs[i];
+            n->jobs[i] -= n->outside[i]; // filled below
+        }
+        n->time = malloc((total > 0 ? total : 1) * sizeof(double));
+    }
+    if (n->time != NULL)
+    {
+        for (long k = 0; k < n->arrivals; k++)
+        {
+            int i = node[k];
+
+            n->time[n->first[i] + n->jobs[i]++] = time[k];
+            s->statistics[i].arrives++;
+        }
+    }
+    free(time);
+    free(node);
+    return (n->time != NULL) ? 0 : -1;
+}
+
+int RunLindley(sim_context *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * run s from its initial state, as RunSimulation(); return 0, 1 if the       *
+     * network is not for the recursion (s is not changed), -1 if out of memory   *
+     * -------------------------------------------------------------------------- */
+    network n;
+    int error = 0;
+
+    if (!LindleyNetwork(s))
+        return 1;
+    if (Jobs(s, &n) != 0)
+    {
+        FreeNetwork(&n);
+        return -1;
+    }
+    for (int pass = 0; pass < 2 && !error; pass++)
+    { // the nodes that feed others first, then the others
+        for (int i = 1; i <= s->top->nodes && !error; i++)
+        {
+            server v;
+
+            if ((pass == 0) != (n.next[i] > 0))
+                continue;
+            if (n.jobs[i] > n.outside[i])
+                error = Merge(s, &n, i);
+            Server(&v, s, i, s->service[s->top->group[i]], &n);
+            while (!error && ServeBlock(&v) > 0)
+                ;
+            Account(s, i, &v);
+        }
+    }
+    if (!error)
+        Finish(s, &n);
+    FreeNetwork(&n);
+    return error;
+}
+
+/* ------------------------- Decomposition by threads ----------------------- */
+
+#define RING 8192 /* departures on the way from a node to the next */
+#define INBOX 256 /* departures taken from a ring at a time       */
+
+// The nodes of a run shared by the threads
+typedef struct
+{
+    sim_context *s;
+    network *n;
+    server *v;      // each node, [1, nodes]
+    rng_stream *r;  // stream of each node that feeds another, [1, nodes]
+    ring **out;     // departures of each node that feeds another
+    int *feeder;    // the nodes that feed another
+    int feeders;
+    int workers;    // threads of the feeders
+    int error;      // out of memory in the consumer
+} decomposition;
+
+// Departures of a node taken from its ring
+typedef struct
+{
+    double x[INBOX];
+    long at, count;
+} inbox;
+
+static void Produce(decomposition *d, int w)
+{
+    /* -------------------------------------------------------------------------- *
+     * worker w: the feeders w, w + workers, ... served a block at a time, each   *
+     * block sent to the ring of the node, and the ring closed at the end; a      *
+     * node whose ring is full waits, while the others of the worker go on        *
+     * -------------------------------------------------------------------------- */
+    for (;;)
+    {
+        int busy = 0, progress = 0;
+
+        for (int f = w; f < d->feeders; f += d->workers)
+        {
+            int i = d->feeder[f];
+            server *v = &d->v[i];
+
+            if (v->sent < v->done)
+            {
+                long k = PutRing(d->out[i], v->a + v->sent, v->done - v->sent);
+
+                v->sent += k;
+                progress |= (k > 0);
+            }
+            if (v->sent == v->done && v->done < v->n)
+                progress |= (ServeBlock(v) > 0);
+            if (v->sent == v->n && !v->closed)
+            {
+                CloseRing(d->out[i]);
+                v->closed = 1;
+            }
+            busy |= !v->closed;
+        }
+        if (!busy)
+            break;
+        if (!progress)
+            sched_yield();
+    }
+}
+
+static int Take(ring *r, inbox *b)
+{
+    /* -------------------------------------------------------------------------- *
+     * the next departures of a ring, waiting for them; 0 at the end of stream    *
+     * -------------------------------------------------------------------------- */
+    long k;
+
+    while ((k = GetRing(r, b->x, INBOX)) == 0)
+        sched_yield();
+    b->at = 0;
+    b->count = (k > 0) ? k : 0;
+    return (k > 0);
+}
+
+static int Consume(decomposition *d, int j)
+{
+    /* -------------------------------------------------------------------------- *
+     * node j as its input arrives: the arrivals from outside (at the end of its  *
+     * jobs) and the departures from the rings of its feeders, merged in order    *
+     * of time on a heap and served as soon as there is a block; return -1 if    *
+     * out of memory                                                              *
+     * -------------------------------------------------------------------------- */
+    network *n = d->n;
+    server *v = &d->v[j];
+    int inputs = 1;
+    int *from;
+    inbox *in;
+    event_list *heads;
+    long w = 0, at = n->jobs[j] - n->outside[j];
+
+    for (int f = 0; f < d->feeders; f++)
+        inputs += (n->next[d->feeder[f]] == j);
+    from = malloc(inputs * sizeof(int));
+    in = malloc(inputs * sizeof(inbox));
+    heads = CreateEventList(EVENT_HEAP, inputs);
+    if (from == NULL || in == NULL || heads == NULL)
+    {
+        free(from);
+        free(in);
+        FreeEventList(heads);
+        return -1;
+    }
+    inputs = 1; // input 0: the arrivals from outside
+    if (at < n->jobs[j])
+        ScheduleEvent(heads, 0, v->a[at]);
+    for (int f = 0; f < d->feeders; f++)
+    {
+        int i = d->feeder[f];
+
+        if (n->next[i] != j)
+            continue;
+        from[inputs] = i;
+        if (Take(d->out[i], &in[inputs]))
+            ScheduleEvent(heads, inputs, in[inputs].x[0]);
+        inputs++;
+    }
+
+    for (int k = NextEvent(heads); k >= 0; k = NextEvent(heads))
+    {
+        if (k == 0)
+        {
+            v->a[w++] = v->a[at++];
+            if (at < n->jobs[j])
+                ScheduleEvent(heads, 0, v->a[at]);
+            else
+                CancelEvent(heads, 0);
+        }
+        else
+        {
+            inbox *b = &in[k];
+
+            v->a[w++] = b->x[b->at++];
+            if (b->at < b->count || Take(d->out[from[k]], b))
+                ScheduleEvent(heads, k, b->x[b->at]);
+            else
+                CancelEvent(heads, k);
+        }
+        if (w - v->done == BLOCK)
+            ServeBlock(v);
+    }
+    while (ServeBlock(v) > 0)
+        ;
+
+    free(from);
+    free(in);
+    FreeEventList(heads);
+    return 0;
+}
+
+static void Task(long t, int worker, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * task t < workers serves feeders, the last one the other nodes              *
+     * -------------------------------------------------------------------------- */
+    decomposition *d = arg;
+    const topology *top = d->s->top;
+
+    if (t < d->workers)
+    {
+        Produce(d, (int)t);
+        return;
+    }
+    for (int j = 1; j <= top->nodes; j++)
+    {
+        if (d->n->next[j] == 0 && !d->error)
+            d->error = Consume(d, j);
+    }
+}
+
+static int OneVariate(const sim_context *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * 1 if every service time takes one random number, so that a stream can be   *
+     * jumped to the variate of any job                                           *
+     * -------------------------------------------------------------------------- */
+    for (int g = 0; g < s->top->groups; g++)
+    {
+        int kind = s->top->service[g].kind;
+
+        if (kind != RV_EXPONENTIAL && kind != RV_BOUNDEDPARETO)
+            return 0;
+    }
+    return 1;
+}
+
+int RunDecomposition(sim_context *s, int threads)
+{
+    /* -------------------------------------------------------------------------- *
+     * run s as RunLindley(), with the nodes that feed others served by threads   *
+     * - 1 threads and the others by one more; return as RunLindley(). Not        *
+     * shown to be faster than RunLindley() (see the top of the file)             *
+     * -------------------------------------------------------------------------- */
+    int nodes = s->top->nodes;
+    decomposition d;
+    network n;
+    long *skip;
+    int error = 0;
+
+    if (threads < 1)
+        threads = DefaultThreads();
+    if (!LindleyNetwork(s))
+        return 1;
+    d.feeders = 0;
+    for (int i = 1; i <= nodes; i++)
+        d.feeders += (Destination(s, i) > 0);
+    if (threads < 2 || d.feeders == 0 || !OneVariate(s))
+        return RunLindley(s); // nothing to run in parallel
+    if (Jobs(s, &n) != 0)
+    {
+        FreeNetwork(&n);
+        return -1;
+    }
+
+    d.s = s;
+    d.n = &n;
+    d.workers = (threads - 1 < d.feeders) ? threads - 1 : d.feeders;
+    d.error = 0;
+    d.v = malloc((nodes + 1) * sizeof(server));
+    d.r = malloc((nodes + 1) * sizeof(rng_stream));
+    d.out = calloc(nodes + 1, sizeof(ring *));
+    d.feeder = malloc(d.feeders * sizeof(int));
+    skip = calloc(s->top->groups, sizeof(long));
+    error = (d.v == NULL || d.r == NULL || d.out == NULL ||
+             d.feeder == NULL || skip == NULL);
+    d.feeders = 0;
+    for (int i = 1; i <= nodes && !error; i++)
+    { // the stream of a feeder jumps to its first variate, as in RunLindley()
+        int g = s->top->group[i];
+
+        if (n.next[i] == 0)
+            continue;
+        d.r[i] = *s->service[g];
+        JumpStream(&d.r[i], skip[g]);
+        skip[g] += n.jobs[i];
+        Server(&d.v[i], s, i, &d.r[i], &n);
+        d.feeder[d.feeders++] = i;
+        error = ((d.out[i] = CreateRing(RING)) == NULL);
+    }
+    for (int g = 0; g < s->top->groups && !error; g++)
+        JumpStream(s->service[g], skip[g]); // then the other nodes
+    for (int i = 1; i <= nodes && !error; i++)
+    {
+        if (n.next[i] == 0)
+            Server(&d.v[i], s, i, s->service[s->top->group[i]], &n);
+    }
+
+    if (!error)
+        error = RunReplications(d.workers + 1, d.workers + 1, Task, &d) != 0 ||
+                d.error != 0;
+    if (!error)
+    {
+        for (int i = 1; i <= nodes; i++)
+            Account(s, i, &d.v[i]);
+        Finish(s, &n);
+    }
+    for (int i = 1; d.out != NULL && i <= nodes; i++)
+        FreeRing(d.out[i]);
+    free(d.v);
+    free(d.r);
+    free(d.out);
+    free(d.feeder);
+    free(skip);
+    FreeNetwork(&n);
+    return error ? -1 : 0;
+}
@@ -0,0 +1,17 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : lindley.h  (header file for the library lindley.c)       *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_LINDLEY_)
+#define _LINDLEY_
+
+#include "netsim.h"
+
+int LindleyNetwork(const sim_context *s);
+int RunLindley(sim_context *s);
+int RunDecomposition(sim_context *s, int threads);
+
+#endif
@@ -0,0 +1,670 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library version of the next-event simulation of the queueing    *
+ * network model of the Wi-Fi network of Campus X (see nsssn_bp.c): APs feed  *
+ * a single switch, interarrival times are Exponential and service times are  *
+ * Bounded Pareto, queues are FIFO with infinite or finite (AP) capacity.     *
+ *                                                                            *
+ * There is no global state: the state of a simulation, including its random *
+ * number streams (rngs_state) and its event list, lives in a sim_context     *
+ * that is passed explicitly to every function. Independent simulations can   *
+ * therefore run at the same time in the same process, for example one per    *
+ * thread. With the same seed and parameters a simulation produces the same   *
+ * results of nsssn_bp.c (purge = 1) and transiente.c (purge = 0).            *
+ * With buffer > 0, interarrival and service times are generated in blocks    *
+ * of buffer variates with SampleFillR (see rvgs.c): faster, but the random   *
+ * numbers are consumed in another order, so the results are different from  *
+ * those of nsssn_bp.c, though statistically the same.                        *
+ *                                                                            *
+ * As in nsssn_bp.c, the routing draws from the stream of the last variate,   *
+ * so a change of lambda or of a service shifts the random numbers of all the *
+ * rest. With crn = 1 every purpose has a stream of its own instead: stream 0 *
+ * for the arrivals, streams + groups for the routing (as lindley.c and       *
+ * pdes.c), streams + groups + i for the services of node i, instead of the   *
+ * stream of its group; two configurations run with the same seed then share  *
+ * common random numbers, job by job (with buffer = 0).                       *
+ *                                                                            *
+ * This is the only copy of the simulation: the original programs only set    *
+ * their parameters and choose their policies,                                *
+ *                                                                            *
+ *   capacity  infinite, or finite for the nodes with a capacity (topology)   *
+ *   stop      doors closed at STOP, then the jobs left are served (purge)    *
+ *             or not, or after departures jobs left the network              *
+ *   analysis  a full run (ReportSimulation), or any other analysis that     *
+ *             looks at every event with ObserveSimulation (see analysis.c)   *
+ *                                                                            *
+ * The loop of the events is compiled once for every combination of the       *
+ * features (finite capacity, departure limit, analysis, areas at every       *
+ * event) and of the source of the variates (the buffers, or the service      *
+ * times all Exponential, all BoundedPareto, or any), with the code of the    *
+ * others left out and the variates computed in place instead of through      *
+ * SampleR(). ResetSimulation() picks the right kernel from the parameters    *
+ * and the topology: a run pays nothing for the features it does not use,     *
+ * and the lazy areas no check for the exact ones. StepSimulation() is the    *
+ * same loop with everything checked at run time (see bench_kernels.c for     *
+ * the difference).                                                           *
+ *                                                                            *
+ * Name            : netsim.c  (Network of Single-Server Service Nodes)       *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include "rngs.h"   /* the multi-stream generator */
+#include "rvgs.h"   /* random variate generators  */
+#include "evlist.h" /* event list management      */
+#include "netsim.h"
+
+#define START 0.0 /* initial time */
+
+#define FINITE 1   /* some queue has a finite capacity          */
+#define LIMIT 2    /* the run ends after a number of departures */
+#define OBSERVE 4  /* an analysis looks at every event          */
+#define EXACT 8    /* areas of every node at every event        */
+#define KERNELS 16 /* combinations of the features above        */
+
+#define SAMPLED 0      /* variates of any distribution, SampleR()   */
+#define EXPONENTIAL 16 /* all the service times are Exponential     */
+#define PARETO 32      /* all the service times are BoundedPareto   */
+#define BUFFER 48      /* variates generated in blocks              */
+#define VARIATES 48    /* the bits of the source of the variates    */
+#define SOURCES 4
+
+#define INLINE static inline __attribute__((always_inline))
+
+void DefaultParams(sim_params *p)
+{
+    /* -------------------------------------------------------------------------- *
+     * parameters of nsssn_bp.c                                                   *
+     * -------------------------------------------------------------------------- */
+    p->lambda = 5;
+    p->alpha = 0.5;
+    p->stop = 30000.0;
+    p->capacity = 0;
+    p->servers = 5;
+    p->ap_min = 0.3756009615;
+    p->ap_max = 8.756197416;
+    p->sw_min = 0.002709302035;
+    p->sw_max = 0.0631606037;
+    p->streams = 1;
+    p->purge = 1;
+    p->event_list = EVENT_HEAP;
+    p->generator = RNG_LEHMER;
+    p->buffer = 0;
+    p->routing = ROUTE_CDF;
+    p->departures = 0;
+    p->crn = 0;
+    p->exact = 0;
+    p->top = NULL;
+}
+
+INLINE double GetArrival(sim_context *s, const int f)
+{
+    /* -------------------------------------------------------------------------- *
+     * generate the next arrival time, with rate lambda                           *
+     * -------------------------------------------------------------------------- */
+    s->last = s->in;
+    if ((f & VARIATES) == BUFFER)
+        s->arrival += NextVariate(s->buffer[0]);
+    else if ((f & VARIATES) != SAMPLED)
+        s->arrival += SampleExponentialR(&s->interarrival, s->in);
+    else
+        s->arrival += SampleR(&s->interarrival, s->in);
+    return (s->arrival);
+}
+
+INLINE double GetService(sim_context *s, int index, const int f)
+{
+    /* -------------------------------------------------------------------------- *
+     * a service time of node index, from the distribution of its group           *
+     * -------------------------------------------------------------------------- */
+    int g = s->top->group[index];
+
+    s->last = s->stream[index];
+    if ((f & VARIATES) == BUFFER)
+        return NextVariate(s->buffer[g + 1]);
+    if ((f & VARIATES) == EXPONENTIAL)
+        return SampleExponentialR(&s->top->service[g], s->stream[index]);
+    if ((f & VARIATES) == PARETO)
+        return SampleBoundedParetoR(&s->top->service[g], s->stream[index]);
+    return SampleR(&s->top->service[g], s->stream[index]);
+}
+
+static int Next(sim_context *s, int from)
+{
+    /* -------------------------------------------------------------------------- *
+     * the node where a job leaving from goes (see routing.c), 0 if it leaves    *
+     * the network; as in nsssn_bp.c, the random number comes                     *
+     * from the stream of the last variate generated, or from its own (crn)      *
+     * -------------------------------------------------------------------------- */
+    return Route(s->top->route, s->p.routing, from,
+                 (s->route != NULL) ? s->route : s->last);
+}
+
+static void Integrate(sim_context *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * with exact, the time-integrated numbers of all the nodes up to the next    *
+     * event, one interval at a time and in the order of nsssn_bp.c, so that the  *
+     * sums are the same doubles; Change() and NodeArea() then add 0              *
+     * -------------------------------------------------------------------------- */
+    for (int i = 0; i < s->p.servers; i++)
+    {
+        s->area[i] += (s->next - s->current) * s->number[i];
+        s->changed[i] = s->next;
+    }
+}
+
+static void Change(sim_context *s, int i, long delta)
+{
+    /* -------------------------------------------------------------------------- *
+     * add delta jobs to node i: its time-integrated number is brought up to now  *
+     * only here, when the number changes, instead of at every event (but with    *
+     * exact, see Integrate())                                                    *
+     * -------------------------------------------------------------------------- */
+    s->area[i] += (s->current - s->changed[i]) * s->number[i];
+    s->changed[i] = s->current;
+    s->number[i] += delta;
+    s->jobs += delta;
+}
+
+INLINE int Full(const sim_context *s, int index, const int f)
+{
+    long capacity;
+
+    if (!(f & FINITE))
+        return 0;
+    capacity = s->top->capacity[index];
+    return (capacity > 0 && s->number[index - 1] > capacity);
+}
+
+INLINE void ProcessArrival(sim_context *s, int index, const int f)
+{
+    /* -------------------------------------------------------------------------- *
+     * function that processes arrivals                                           *
+     * -------------------------------------------------------------------------- */
+    if (s->number[index - 1] == 0)
+    { // if the queue is empty, serve it immediately
+        double service_time = GetService(s, index, f);
+        ScheduleEvent(s->event, index, service_time + s->current);
+        s->statistics[index].service += service_time;
+        s->statistics[index].served++;
+    }
+
+    Change(s, index - 1, 1);
+}
+
+INLINE void ProcessDeparture(sim_context *s, int index, const int f)
+{
+    /* -------------------------------------------------------------------------- *
+     * function that processes departures                                         *
+     * -------------------------------------------------------------------------- */
+    int to = Next(s, index);
+
+    if (to > 0 && Full(s, to, f))
+    {
+        s->refused++; // the queue of the next node is full, the job is lost
+    }
+    else if (to > 0)
+    {
+        ProcessArrival(s, to, f); // APs send the job to the switch
+    }
+    else
+    {
+        s->departures++; // else the job leaves the system
+    }
+
+    Change(s, index - 1, -1);
+
+    if (s->number[index - 1] > 0)
+    { // schedule next departure from this node
+        double service_time = GetService(s, index, f);
+        ScheduleEvent(s->event, index, service_time + s->current);
+        s->statistics[index].service += service_time;
+        s->statistics[index].served++;
+    }
+    else
+    {
+        CancelEvent(s->event, index);
+    }
+}
+
+static int SetBuffer(rv_buffer **b, const rv_dist *d, rng_stream *r,
+                     long size)
+{
+    /* -------------------------------------------------------------------------- *
+     * an empty buffer of size variates of d from r, 0 for no buffer              *
+     * -------------------------------------------------------------------------- */
+    if (*b != NULL && (*b)->size != size)
+    {
+        FreeBuffer(*b);
+        *b = NULL;
+    }
+    if (size <= 0)
+        return 0;
+    if (*b == NULL && (*b = CreateBuffer(d, r, size)) == NULL)
+        return -1;
+    (*b)->d = *d;
+    (*b)->r = r;
+    EmptyBuffer(*b);
+    return 0;
+}
+
+sim_context *CreateSimulation(const sim_params *p, long seed)
+{
+    /* -------------------------------------------------------------------------- *
+     * allocate a simulation and plant its own streams with seed (see rngs.c)     *
+     * -------------------------------------------------------------------------- */
+    sim_context *s = calloc(1, sizeof(sim_context));
+
+    if (s == NULL)
+        return NULL;
+    if (ResetSimulation(s, p, seed) != 0)
+    {
+        FreeSimulation(s);
+        return NULL;
+    }
+    return (s);
+}
+
+static int Variates(const topology *t, long buffer)
+{
+    /* -------------------------------------------------------------------------- *
+     * where the variates come from: the buffers, or the inline sampler of the    *
+     * distribution when every group has the same one, else SampleR()             *
+     * -------------------------------------------------------------------------- */
+    int exponential = 1, pareto = 1;
+
+    if (buffer > 0)
+        return BUFFER;
+    for (int g = 0; g < t->groups; g++)
+    {
+        exponential &= (t->service[g].kind == RV_EXPONENTIAL);
+        pareto &= (t->service[g].kind == RV_BOUNDEDPARETO);
+    }
+    return exponential ? EXPONENTIAL : (pareto ? PARETO : SAMPLED);
+}
+
+static int SetGroups(sim_context *s, int groups)
+{
+    /* -------------------------------------------------------------------------- *
+     * streams and buffers for groups groups                                      *
+     * -------------------------------------------------------------------------- */
+    rng_stream **service;
+    rv_buffer **buffer;
+
+    if (groups <= s->groups)
+        return 0;
+    if ((service = realloc(s->service, groups * sizeof(rng_stream *))) == NULL)
+        return -1;
+    s->service = service;
+    if ((buffer = realloc(s->buffer, (groups + 1) * sizeof(rv_buffer *))) == NULL)
+        return -1;
+    s->buffer = buffer;
+    for (int i = (s->groups > 0) ? s->groups + 1 : 0; i <= groups; i++)
+        s->buffer[i] = NULL;
+    s->groups = groups;
+    return 0;
+}
+
+int ResetSimulation(sim_context *s, const sim_params *p, long seed)
+{
+    /* -------------------------------------------------------------------------- *
+     * give a simulation new parameters and seed; its memory is reused when the   *
+     * network is not larger than before and the event list is of the same kind; *
+     * return -1 if out of memory or the parameters are not valid                 *
+     * -------------------------------------------------------------------------- */
+    int servers;
+
+    FreeTopology(s->campus);
+    s->campus = NULL;
+    if (p->top == NULL &&
+        (s->campus = CampusTopology(p->servers, p->alpha, p->ap_min,
+                                    p->ap_max, p->sw_min, p->sw_max,
+                                    p->capacity)) == NULL)
+        return -1;
+    s->top = (p->top != NULL) ? p->top : s->campus;
+    servers = s->top->nodes;
+    if (s->event == NULL || servers > s->size ||
+        p->event_list != s->p.event_list)
+    {
+        int size = (servers > s->size) ? servers : s->size;
+
+        FreeEventList(s->event);
+        free(s->number);
+        free(s->area);
+        free(s->changed);
+        free(s->statistics);
+        free(s->stream);
+        s->event = CreateEventList(p->event_list, size + 1);
+        s->number = calloc(size, sizeof(long));
+        s->area = calloc(size, sizeof(double));
+        s->changed = calloc(size, sizeof(double));
+        s->statistics = calloc(size + 1, sizeof(sim_sum));
+        s->stream = calloc(size + 1, sizeof(rng_stream *));
+        s->size = size;
+        if (s->event == NULL || s->number == NULL || s->area == NULL ||
+            s->changed == NULL || s->statistics == NULL || s->stream == NULL)
+            return -1;
+    }
+    if (SetGroups(s, s->top->groups) != 0 ||
+        ExponentialDist(&s->interarrival, 1.0 / p->lambda) != 0 ||
+        (p->crn && SimulationStreams(p) > STREAMS))
+        return -1;
+    s->p = *p;
+    s->p.servers = servers;
+    s->features = (p->departures > 0 ? LIMIT : 0) | (p->exact ? EXACT : 0);
+    for (int i = 1; i <= servers; i++)
+    {
+        if (s->top->capacity[i] > 0)
+            s->features |= FINITE;
+    }
+    s->features |= Variates(s->top, p->buffer);
+    InitStreamsR(&s->rng);
+    SetGeneratorR(&s->rng, p->generator);
+    PlantSeedsR(&s->rng, seed);
+    s->in = StreamR(&s->rng, 0);
+    if (SetBuffer(&s->buffer[0], &s->interarrival, s->in, p->buffer) != 0)
+        return -1;
+    for (int g = 0; g < s->top->groups; g++)
+    {
+        s->service[g] = StreamR(&s->rng, p->streams + g);
+        if (SetBuffer(&s->buffer[g + 1], &s->top->service[g], s->service[g],
+                      p->buffer) != 0)
+            return -1;
+    }
+    s->route = p->crn ? StreamR(&s->rng, p->streams + s->top->groups) : NULL;
+    for (int i = 1; i <= servers; i++)
+    {
+        s->stream[i] = p->crn ? StreamR(&s->rng, p->streams + s->top->groups + i)
+                              : s->service[s->top->group[i]];
+    }
+    InitSimulation(s);
+    return 0;
+}
+
+void FreeSimulation(sim_context *s)
+{
+    if (s == NULL)
+        return;
+    FreeEventList(s->event);
+    free(s->number);
+    free(s->area);
+    free(s->changed);
+    free(s->statistics);
+    free(s->stream);
+    for (int i = 0; s->buffer != NULL && i <= s->groups; i++)
+        FreeBuffer(s->buffer[i]);
+    free(s->buffer);
+    free(s->service);
+    FreeTopology(s->campus);
+    free(s);
+}
+
+void InitSimulation(sim_context *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * reset clock, nodes and statistics, and schedule the first arrival; the     *
+     * streams go on from their current state, as between replications, and the  *
+     * variates left in the buffers are dropped, since the streams may have been  *
+     * planted again                                                              *
+     * -------------------------------------------------------------------------- */
+    for (int i = 0; i <= s->top->groups && s->p.buffer > 0; i++)
+        EmptyBuffer(s->buffer[i]);
+    for (int i = 0; i < s->p.servers; i++)
+    {
+        s->number[i] = 0;
+        s->area[i] = 0.0;
+        s->changed[i] = START;
+    }
+    for (int i = 0; i <= s->p.servers; i++)
+    {
+        s->statistics[i].service = 0.0;
+        s->statistics[i].served = 0;
+        s->statistics[i].arrives = 0;
+    }
+    s->arrivals = 0;
+    s->departures = 0;
+    s->refused = 0;
+    s->jobs = 0;
+    s->arrival = START;
+    s->current = START;
+    s->next = START;
+    ClearEvents(s->event);
+    ScheduleEvent(s->event, 0, GetArrival(s, s->features)); // first arrival
+}
+
+int SimulationStreams(const sim_params *p)
+{
+    /* -------------------------------------------------------------------------- *
+     * the streams used with p, 0, 1, ..., SimulationStreams() - 1: those to      *
+     * plant for a replication (see PlantReplicationR); the campus has two        *
+     * groups, the APs and the switch                                             *
+     * -------------------------------------------------------------------------- */
+    int groups = (p->top != NULL) ? p->top->groups : 2;
+    int nodes = (p->top != NULL) ? p->top->nodes : p->servers;
+
+    if (p->crn)
+        return p->streams + groups + nodes + 1;
+    return p->streams + groups;
+}
+
+INLINE int Done(const sim_context *s, const int f)
+{
+    /* -------------------------------------------------------------------------- *
+     * the doors close at STOP; with purge the jobs still in the network are      *
+     * served before the simulation ends; with a limit of departures it ends      *
+     * as soon as they have left the network                                      *
+     * -------------------------------------------------------------------------- */
+    if ((f & LIMIT) && s->departures >= s->p.departures)
+        return 1;
+    if (EventTime(s->event, 0) < s->p.stop)
+        return 0;
+    return (!s->p.purge || s->jobs == 0);
+}
+
+INLINE int Step(sim_context *s, const int f, sim_observer *observe, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * process the next event, return 0 if the simulation is over; the features   *
+     * f are constant in every kernel, so the code of the others is left out      *
+     * -------------------------------------------------------------------------- */
+    int e;
+
+    if (Done(s, f))
+        return 0;
+
+    e = NextEvent(s->event);
+    s->next = EventTime(s->event, e);
+    if ((f & OBSERVE) && !observe(s, e, arg))
+        return 0;
+    if (f & EXACT)
+        Integrate(s);
+    s->current = s->next;
+
+    if (e == 0)
+    {
+        // Process an Arrival
+        int index;
+
+        s->arrivals++;
+        index = Next(s, 0);
+        if (Full(s, index, f))
+        {
+            s->refused++; // the queue is full, the job is lost
+        }
+        else
+        {
+            s->statistics[index].arrives++;
+            ProcessArrival(s, index, f);
+        }
+
+        ScheduleEvent(s->event, 0, GetArrival(s, f)); // Scheduling Next Arrival
+        if (EventTime(s->event, 0) > s->p.stop)
+        {
+            CancelEvent(s->event, 0);
+        }
+    }
+    else
+    {
+        // Process a Departure (e indicates server number)
+        ProcessDeparture(s, e, f);
+    }
+    return 1;
+}
+
+// The kernels: the loop of the events for each source of the variates (n, v)
+// and each combination of features f
+#define KERNEL(n, v, f)                                                        \
+    static void Run_##n##_##f(sim_context *s, sim_observer *observe,          \
+                              void *arg)                                       \
+    {                                                                          \
+        while (Step(s, (v) | (f), observe, arg))                               \
+            ;                                                                  \
+    }
+#define KERNELS_OF(n, v)                                                       \
+    KERNEL(n, v, 0) KERNEL(n, v, 1) KERNEL(n, v, 2) KERNEL(n, v, 3)            \
+    KERNEL(n, v, 4) KERNEL(n, v, 5) KERNEL(n, v, 6) KERNEL(n, v, 7)            \
+    KERNEL(n, v, 8) KERNEL(n, v, 9) KERNEL(n, v, 10) KERNEL(n, v, 11)          \
+    KERNEL(n, v, 12) KERNEL(n, v, 13) KERNEL(n, v, 14) KERNEL(n, v, 15)
+#define TABLE_OF(n)                                                            \
+    {Run_##n##_0, Run_##n##_1, Run_##n##_2, Run_##n##_3, Run_##n##_4,          \
+     Run_##n##_5, Run_##n##_6, Run_##n##_7, Run_##n##_8, Run_##n##_9,          \
+     Run_##n##_10, Run_##n##_11, Run_##n##_12, Run_##n##_13, Run_##n##_14,     \
+     Run_##n##_15}
+
+KERNELS_OF(sampled, SAMPLED)
+KERNELS_OF(exp, EXPONENTIAL)
+KERNELS_OF(bp, PARETO)
+KERNELS_OF(buffer, BUFFER)
+
+static void (*const kernel[SOURCES][KERNELS])(sim_context *, sim_observer *,
+                                              void *) = {
+    TABLE_OF(sampled), TABLE_OF(exp), TABLE_OF(bp), TABLE_OF(buffer)};
+
+int SimulationDone(const sim_context *s)
+{
+    return Done(s, s->features);
+}
+
+int StepSimulation(sim_context *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * process the next event, return 0 if the simulation is over (the features   *
+     * are checked at every event and the variates come from SampleR() or the     *
+     * buffers, as in a loop written for all of them)                             *
+     * -------------------------------------------------------------------------- */
+    int f = s->features;
+
+    if ((f & VARIATES) != BUFFER)
+        f &= ~VARIATES;
+    return Step(s, f, NULL, NULL);
+}
+
+void RunSimulation(sim_context *s)
+{
+    kernel[s->features / KERNELS][s->features % KERNELS](s, NULL, NULL);
+}
+
+void ObserveSimulation(sim_context *s, sim_observer *observe, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * run the simulation calling observe before every event e, when s->next is   *
+     * its time and s->current still the time of the one before; the run ends    *
+     * (before e) if observe returns 0                                            *
+     * -------------------------------------------------------------------------- */
+    kernel[s->features / KERNELS][(s->features % KERNELS) | OBSERVE](
+        s, observe, arg);
+}
+
+double NodeArea(const sim_context *s, int i)
+{
+    /* -------------------------------------------------------------------------- *
+     * time-integrated number of jobs in node i, [0, servers), up to now          *
+     * -------------------------------------------------------------------------- */
+    return s->area[i] + (s->current - s->changed[i]) * s->number[i];
+}
+
+double AvgWait(const sim_context *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * Average Waiting Time of Users: the mean wait over the nodes of each group, *
+     * summed over the groups (for the campus, the mean wait over the APs plus    *
+     * the wait at the switch)                                                    *
+     * -------------------------------------------------------------------------- */
+    const topology *t = s->top;
+    double avg_wait = 0.0;
+
+    for (int g = 0; g < t->groups; g++)
+    {
+        double wait = 0.0;
+
+        for (int i = t->first[g]; i < t->first[g] + t->count[g]; i++)
+        {
+            wait += NodeArea(s, i - 1) / s->statistics[i].served;
+        }
+        avg_wait += wait / t->count[g];
+    }
+    return avg_wait;
+}
+
+void ReportSimulation(FILE *f, const sim_context *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * print the output statistics in the layout of nsssn_bp.c                    *
+     * -------------------------------------------------------------------------- */
+    double tot_area = 0.0;
+    long capacity = 0;
+
+    for (int i = 0; i < s->p.servers; i++)
+    {
+        tot_area += NodeArea(s, i);
+        capacity += s->top->capacity[i + 1];
+    }
+    if (capacity > 0)
+    {
+        fprintf(f, "Output Statistics (computed using %ld jobs) are:\n",
+                s->departures);
+        fprintf(f, "[Refused Jobs: %ld (%4.2f %%)]\n\n", s->refused,
+                100.0 * s->refused / s->arrivals);
+    }
+    else
+    {
+        fprintf(f, "Output Statistics (computed using %ld jobs) are:\n\n",
+                s->departures);
+    }
+    fprintf(f, "1) Global Statistics\n");
+    fprintf(f, "  avg interarrival time = %6.6f\n",
+            EventTime(s->event, 0) / s->arrivals);
+    fprintf(f, "  avg waiting time = %6.6f\n", tot_area / s->departures);
+    fprintf(f, "  avg number of jobs in the network = %6.2f\n",
+            tot_area / s->current);
+
+    for (int i = 1; i <= s->p.servers; i++)
+    {
+        tot_area -= s->statistics[i].service;
+    }
+    fprintf(f, "  avg delay = %6.6f\n", tot_area / s->departures);
+    fprintf(f, "  avg number of jobs in queues = %6.6f\n",
+            tot_area / s->current);
+    fprintf(f, "\n");
+    fprintf(f, "\n");
+
+    fprintf(f, "2) Local Statistics\n");
+    fprintf(f, "  server     utilization   avg service   share        ");
+    fprintf(f, "avg wait      avg delay\n");
+
+    for (int i = 1; i <= s->p.servers; i++)
+    {
+        const sim_sum *n = &s->statistics[i];
+        fprintf(f, "   %s-", s->top->name[s->top->group[i]]);
+        fprintf(f, "%d %13.6f %13.6f %13.6f %13.6f %13.6f\n", i,
+                n->service / s->current,
+                n->service / n->served,
+                (double)n->arrives / s->arrivals,
+                NodeArea(s, i - 1) / n->served,
+                (NodeArea(s, i - 1) - n->service) / n->served);
+    }
+    fprintf(f, "\n");
+    fprintf(f, "  Average Waiting Time of Users: %13.6f\n", AvgWait(s));
+}
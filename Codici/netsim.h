@@ -0,0 +1,107 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : netsim.h  (header file for the library netsim.c)         *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_NETSIM_)
+#define _NETSIM_
+
+#include <stdio.h>
+#include "rngs.h"
+#include "rvgs.h"
+#include "evlist.h"
+#include "routing.h"
+#include "topology.h"
+
+// Parameters of the model
+typedef struct
+{
+    double lambda;         // traffic flow rate
+    double alpha;          // shape parameter of BP distribution
+    double stop;           // terminal (close the door) time
+    long capacity;         // AP queue capacity, 0 if infinite
+    int servers;           // servers - 1 APs and one switch (the nodes)
+    double ap_min, ap_max; // bounds of the service time of the APs
+    double sw_min, sw_max; // bounds of the service time of the switch
+    int streams;           // stream of group 0, the APs (group g: + g)
+    int purge;             // serve the jobs left after STOP (1) or not (0)
+    int event_list;        // event list implementation, see evlist.h
+    int generator;         // random number generator, see rngs.h
+    long buffer;           // variates generated in blocks, 0 one at a time
+    int routing;           // sampling of the routing, see routing.h
+    long departures;       // end after departures jobs left the network,
+                           //   0 for no limit
+    int crn;               // a stream for each purpose (1), or the routing
+                           //   from the stream of the last variate (0)
+    int exact;             // areas summed at every event for every node, as
+                           //   nsssn_bp.c (1), or only when they change (0):
+                           //   the same sums in another order, which differ
+                           //   only in the last bits
+    const topology *top;   // network to simulate, NULL for the campus of
+                           //   servers, alpha, capacity and the bounds
+} sim_params;
+
+// Output Statistics of a node
+typedef struct
+{                   // aggregated sums of:
+    double service; //   service times
+    long served;    //   number of served jobs
+    long arrives;   //   arrives in the node
+} sim_sum;
+
+// State of one simulation
+typedef struct
+{
+    sim_params p;
+    rngs_state rng;         // streams owned by this simulation
+    const topology *top;    // network simulated: p.top or the campus
+    topology *campus;       // the campus, when p.top is NULL
+    rng_stream *in;         // stream of the arrivals
+    rng_stream **service;   // stream of the service times of each group
+    rng_stream *last;       // stream of the last variate, used by routing
+    rng_stream *route;      //   unless there is one of its own (crn)
+    rng_stream **stream;    // stream of the service times of each node,
+                            //   [1, servers]: of its group, or its own (crn)
+    rv_dist interarrival;   // Exponential(1 / lambda)
+    rv_buffer **buffer;     // blocks of interarrival (0) and service times
+                            //   of each group (1, 2, ...)
+    event_list *event;      // next events
+    double current;         // current time
+    double next;            // next-event time
+    double arrival;         // last arrival time generated
+    long *number;           // number of jobs in the node, [0, servers)
+    double *area;           // time-integrated number, [0, servers), up to
+    double *changed;        //   the last change of number: see NodeArea()
+    sim_sum *statistics;    // output statistics, [1, servers]
+    long arrivals;          // number of arrivals
+    long departures;        // number of departures
+    long refused;           // number of jobs lost
+    long jobs;              // number of jobs in the network
+    int size;               // servers allocated
+    int groups;             // groups allocated
+    int features;           // features used, to choose the loop of events
+} sim_context;
+
+// An output analysis: called before event e, 0 to end the run
+typedef int sim_observer(sim_context *s, int e, void *arg);
+
+void DefaultParams(sim_params *p);
+
+sim_context *CreateSimulation(const sim_params *p, long seed);
+int ResetSimulation(sim_context *s, const sim_params *p, long seed);
+void FreeSimulation(sim_context *s);
+void InitSimulation(sim_context *s);
+int SimulationStreams(const sim_params *p);
+
+int SimulationDone(const sim_context *s);
+int StepSimulation(sim_context *s);
+void RunSimulation(sim_context *s);
+void ObserveSimulation(sim_context *s, sim_observer *observe, void *arg);
+
+double NodeArea(const sim_context *s, int i);
+double AvgWait(const sim_context *s);
+void ReportSimulation(FILE *f, const sim_context *s);
+
+#endif
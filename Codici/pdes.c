@@ -0,0 +1,764 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library that runs the next-event simulation of a network of      *
+ * single-server nodes (any topology, see topology.c) on threads, with        *
+ * conservative synchronization: the nodes are split between the threads,     *
+ * each a logical process with its own event list, and a thread processes     *
+ * an event only when no job from another thread can arrive before it.        *
+ *                                                                            *
+ * The guarantee comes from the lookahead of the service times: when a node   *
+ * starts a service it draws the service time and the destination of the      *
+ * job at once, and sends the arrival at the next node immediately, so a      *
+ * thread whose next event is at t cannot send anything before t + L, with L  *
+ * the minimum service time of its nodes that feed the other thread (the      *
+ * lower bound of a BoundedPareto: 0.3756 for the APs, 0.0027 for the         *
+ * switch). The threads proceed in rounds, as the windows of YAWNS (D. M.     *
+ * Nicol, 1993): between two barriers each thread reports the time of its     *
+ * next event, one of them computes for every thread the bound                *
+ *                                                                            *
+ *   B[w] = min over the v that feed w of min(next[v], B[v]) + L[v][w]        *
+ *                                                                            *
+ * (shortest paths on the graph of the threads, so cycles are allowed), and   *
+ * then each thread processes all its events before B[w], sending the new     *
+ * arrivals for the others to mailboxes read at the next round. A thread      *
+ * that only the arrivals from outside feed, as those of the APs, has no      *
+ * bound and runs to the end in one round.                                    *
+ *                                                                            *
+ * The arrivals from outside are drawn before the run, up to STOP (purge),    *
+ * and every node has its own stream of service times and routing, jumped     *
+ * from the stream of its group (see JumpStream in rngs.c): each node sees    *
+ * the same jobs whatever the threads, so the results do not depend on their  *
+ * number. They are statistically, not exactly, those of netsim.c, whose      *
+ * nodes share the streams. Queues can have a finite capacity, decided by     *
+ * the node at the arrival; a limit of departures and purge = 0 need the      *
+ * global state and are left to netsim.c, as a partition where some job can   *
+ * cross threads with no lookahead (an Exponential service time).             *
+ *                                                                            *
+ * Name            : pdes.c  (Parallel Discrete-Event Simulation)             *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <math.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "rngs.h"      /* the multi-stream generator */
+#include "rvgs.h"      /* random variate generators  */
+#include "evlist.h"    /* event list management      */
+#include "replicate.h" /* number of cores            */
+#include "netsim.h"
+#include "pdes.h"
+
+#define NODE_JUMP (1LL << 40) /* draws between the streams of two nodes  */
+                              /*   (MRG32k3a; Lehmer: the stream split)  */
+
+// The arrival of a job at a node
+typedef struct
+{
+    double t;  // time
+    int node;  // destination
+    int from;  // node it leaves, 0 from outside (the order of equal times)
+} message;
+
+// Messages, as a list (mailbox) or in order of time (binary heap)
+typedef struct
+{
+    message *m;
+    long n, size;
+} queue;
+
+// State of a node
+typedef struct
+{
+    rng_stream r;  // service times and routing
+    long number;   // jobs in the node
+    double area;   // time-integrated number, up to changed
+    double changed;
+    int to;        // destination of the job in service, 0 for the exit
+    sim_sum sum;   // output statistics
+    long left;     // jobs that left the network from here
+    long refused;  // jobs lost here
+} station;
+
+// A thread: a logical process
+typedef struct
+{
+    int first, last;    // its nodes first, ..., last - 1
+    event_list *event;  // departures of its nodes
+    queue in;           // arrivals at its nodes (heap)
+    message *outside;   // arrivals from outside at its nodes, in order
+    long arrivals, at;  //   how many, and the next one
+    double next;        // time of its next event
+    double bound;       // no arrival from others before bound
+    double current;     // time of its last event
+    int error;          // out of memory
+} process;
+
+// A run shared by the threads
+typedef struct
+{
+    sim_context *s;
+    int processes;
+    process *lp;
+    int *owner;         // process of each node, [1, nodes]
+    station *node;      // [1, nodes]
+    double *lookahead;  // [v * processes + w]: INFINITY if v does not feed w
+    queue *box;         // [v * processes + w]: arrivals from v to w
+    pthread_barrier_t barrier;
+    pthread_mutex_t lock;   // the threads wait at the gate until go is 1
+    pthread_cond_t gate;    //   (run) or -1 (called off)
+    int go;
+    struct worker *thread;  // [1, processes): process 0 is the caller
+    int done;
+    long rounds;
+} pdes;
+
+// A thread and the process it runs
+typedef struct worker
+{
+    pdes *d;
+    int p;
+    pthread_t id;
+} worker;
+
+static int Push(queue *q, message m)
+{
+    /* -------------------------------------------------------------------------- *
+     * append m to a mailbox, return -1 if out of memory                          *
+     * -------------------------------------------------------------------------- */
+    if (q->n == q->size)
+    {
+        message *x = realloc(q->m, 2 * (q->size + 64) * sizeof(message));
+
+        if (x == NULL)
+            return -1;
+        q->m = x;
+        q->size = 2 * (q->size + 64);
+    }
+    q->m[q->n++] = m;
+    return 0;
+}
+
+static int Before(const message *a, const message *b)
+{
+    return (a->t < b->t || (a->t == b->t && a->from < b->from));
+}
+
+static int HeapPush(queue *h, message m)
+{
+    /* -------------------------------------------------------------------------- *
+     * insert m in a heap of messages, return -1 if out of memory                 *
+     * -------------------------------------------------------------------------- */
+    long i;
+
+    if (Push(h, m) != 0)
+        return -1;
+    for (i = h->n - 1; i > 0 && Before(&m, &h->m[(i - 1) / 2]); i = (i - 1) / 2)
+        h->m[i] = h->m[(i - 1) / 2];
+    h->m[i] = m;
+    return 0;
+}
+
+static message HeapPop(queue *h)
+{
+    /* -------------------------------------------------------------------------- *
+     * remove the first message of a heap that is not empty                       *
+     * -------------------------------------------------------------------------- */
+    message top = h->m[0], last = h->m[--h->n];
+    long i = 0;
+
+    for (;;)
+    {
+        long c = 2 * i + 1;
+
+        if (c >= h->n)
+            break;
+        if (c + 1 < h->n && Before(&h->m[c + 1], &h->m[c]))
+            c++;
+        if (!Before(&h->m[c], &last))
+            break;
+        h->m[i] = h->m[c];
+        i = c;
+    }
+    if (h->n > 0)
+        h->m[i] = last;
+    return top;
+}
+
+static double Minimum(const rv_dist *d)
+{
+    /* -------------------------------------------------------------------------- *
+     * the minimum of a service time: the lower bound of a BoundedPareto, 0 for   *
+     * the others                                                                 *
+     * -------------------------------------------------------------------------- */
+    return (d->kind == RV_BOUNDEDPARETO) ? d->a : 0.0;
+}
+
+static void Change(station *x, double t, long delta)
+{
+    x->area += (t - x->changed) * x->number;
+    x->changed = t;
+    x->number += delta;
+}
+
+static int Start(pdes *d, int p, int i, double t)
+{
+    /* -------------------------------------------------------------------------- *
+     * node i of process p starts a service at t: its departure and the arrival   *
+     * at the next node are known now; return -1 if out of memory                 *
+     * -------------------------------------------------------------------------- */
+    const topology *top = d->s->top;
+    station *x = &d->node[i];
+    double service = SampleR(&top->service[top->group[i]], &x->r);
+    message m;
+
+    x->to = Route(top->route, d->s->p.routing, i, &x->r);
+    x->sum.service += service;
+    x->sum.served++;
+    ScheduleEvent(d->lp[p].event, i - d->lp[p].first, t + service);
+    if (x->to == 0)
+        return 0;
+    m.t = t + service;
+    m.node = x->to;
+    m.from = i;
+    if (d->owner[x->to] == p)
+        return HeapPush(&d->lp[p].in, m);
+    return Push(&d->box[p * d->processes + d->owner[x->to]], m);
+}
+
+static int Arrival(pdes *d, int p, const message *m)
+{
+    const topology *top = d->s->top;
+    station *x = &d->node[m->node];
+
+    Change(x, m->t, 0);
+    if (top->capacity[m->node] > 0 && x->number > top->capacity[m->node])
+    {
+        x->refused++; // the queue is full, the job is lost
+        return 0;
+    }
+    if (m->from == 0)
+        x->sum.arrives++;
+    x->number++;
+    if (x->number == 1)
+        return Start(d, p, m->node, m->t);
+    return 0;
+}
+
+static int Departure(pdes *d, int p, int i, double t)
+{
+    station *x = &d->node[i];
+
+    Change(x, t, -1);
+    if (x->to == 0)
+        x->left++;
+    if (x->number > 0)
+        return Start(d, p, i, t);
+    CancelEvent(d->lp[p].event, i - d->lp[p].first);
+    return 0;
+}
+
+static const message *First(const process *lp)
+{
+    /* -------------------------------------------------------------------------- *
+     * the next arrival of a process, in order of time and of origin, NULL if     *
+     * none                                                                       *
+     * -------------------------------------------------------------------------- */
+    const message *a = (lp->in.n > 0) ? &lp->in.m[0] : NULL;
+    const message *o = (lp->at < lp->arrivals) ? &lp->outside[lp->at] : NULL;
+
+    if (a == NULL || (o != NULL && Before(o, a)))
+        return o;
+    return a;
+}
+
+static double NextTime(const process *lp)
+{
+    /* -------------------------------------------------------------------------- *
+     * time of the next event of a process, INFINITY if none                      *
+     * -------------------------------------------------------------------------- */
+    const message *a = First(lp);
+    int e = NextEvent(lp->event);
+    double t = (e >= 0) ? EventTime(lp->event, e) : INFINITY;
+
+    return (a != NULL && a->t < t) ? a->t : t;
+}
+
+static int Advance(pdes *d, int p)
+{
+    /* -------------------------------------------------------------------------- *
+     * process the events of p before its bound, a departure before an arrival    *
+     * at the same time; return -1 if out of memory                               *
+     * -------------------------------------------------------------------------- */
+    process *lp = &d->lp[p];
+    int error = 0;
+
+    while (!error)
+    {
+        const message *a = First(lp);
+        int e = NextEvent(lp->event);
+        double t = (e >= 0) ? EventTime(lp->event, e) : INFINITY;
+
+        if (a != NULL && a->t < t)
+        { // an arrival
+            message m = *a;
+
+            if (m.t >= lp->bound)
+                break;
+            if (lp->in.n > 0 && a == &lp->in.m[0])
+                HeapPop(&lp->in);
+            else
+                lp->at++;
+            lp->current = m.t;
+            error = Arrival(d, p, &m);
+        }
+        else if (e >= 0 && t < lp->bound)
+        {
+            lp->current = t;
+            error = Departure(d, p, lp->first + e, t);
+        }
+        else
+            break;
+    }
+    return error;
+}
+
+static void Bounds(pdes *d)
+{
+    /* -------------------------------------------------------------------------- *
+     * the bound of every process: the earliest time of an arrival from another,  *
+     * by relaxation of B[w] = min over v of min(next[v], B[v]) + L[v][w]         *
+     * -------------------------------------------------------------------------- */
+    int n = d->processes, changed = 1;
+
+    for (int w = 0; w < n; w++)
+        d->lp[w].bound = INFINITY;
+    for (int k = 0; k < n && changed; k++)
+    {
+        changed = 0;
+        for (int v = 0; v < n; v++)
+        {
+            double t = fmin(d->lp[v].next, d->lp[v].bound);
+
+            for (int w = 0; w < n; w++)
+            {
+                double b = t + d->lookahead[v * n + w];
+
+                if (b < d->lp[w].bound)
+                {
+                    d->lp[w].bound = b;
+                    changed = 1;
+                }
+            }
+        }
+    }
+}
+
+static void Process(pdes *d, int p)
+{
+    /* -------------------------------------------------------------------------- *
+     * the rounds of process p: read the mailboxes, report the next event, wait   *
+     * for the bounds, advance                                                    *
+     * -------------------------------------------------------------------------- */
+    process *lp = &d->lp[p];
+
+    for (;;)
+    {
+        for (int v = 0; v < d->processes; v++)
+        {
+            queue *box = &d->box[v * d->processes + p];
+
+            for (long k = 0; k < box->n && !lp->error; k++)
+                lp->error = HeapPush(&lp->in, box->m[k]);
+            box->n = 0;
+        }
+        lp->next = NextTime(lp);
+        pthread_barrier_wait(&d->barrier);
+        if (p == 0)
+        { // the end when no process has events or an error
+            int events = 0, error = 0;
+
+            for (int w = 0; w < d->processes; w++)
+            {
+                events |= (d->lp[w].next < INFINITY);
+                error |= d->lp[w].error;
+            }
+            d->done = (!events || error);
+            if (!d->done)
+            {
+                Bounds(d);
+                d->rounds++;
+            }
+        }
+        pthread_barrier_wait(&d->barrier);
+        if (d->done)
+            break;
+        if (!lp->error)
+            lp->error = Advance(d, p);
+        pthread_barrier_wait(&d->barrier);
+    }
+}
+
+static void *Thread(void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * a process on its own thread, once the gate opens                           *
+     * -------------------------------------------------------------------------- */
+    worker *w = arg;
+    pdes *d = w->d;
+    int go;
+
+    pthread_mutex_lock(&d->lock);
+    while (d->go == 0)
+        pthread_cond_wait(&d->gate, &d->lock);
+    go = d->go;
+    pthread_mutex_unlock(&d->lock);
+    if (go > 0)
+        Process(d, w->p);
+    return NULL;
+}
+
+static void Release(pdes *d, int go, int threads)
+{
+    /* -------------------------------------------------------------------------- *
+     * open the gate to run the processes (go = 1, process 0 in this thread) or   *
+     * to call them off (go = -1), then join threads 1, ..., threads - 1          *
+     * -------------------------------------------------------------------------- */
+    pthread_mutex_lock(&d->lock);
+    d->go = go;
+    pthread_cond_broadcast(&d->gate);
+    pthread_mutex_unlock(&d->lock);
+    if (go > 0)
+        Process(d, 0);
+    for (int p = 1; p < threads; p++)
+        pthread_join(d->thread[p].id, NULL);
+    pthread_barrier_destroy(&d->barrier);
+    pthread_cond_destroy(&d->gate);
+    pthread_mutex_destroy(&d->lock);
+}
+
+static int Launch(pdes *d)
+{
+    /* -------------------------------------------------------------------------- *
+     * the barrier and the threads of processes 1, 2, ..., waiting at the gate    *
+     * for Release(), before the run changes the simulation; return -1, with no   *
+     * thread left, if any of them cannot be created                              *
+     * -------------------------------------------------------------------------- */
+    int p;
+
+    d->go = 0;
+    if ((d->thread = calloc(d->processes, sizeof(worker))) == NULL)
+        return -1;
+    if (pthread_barrier_init(&d->barrier, NULL, d->processes) != 0)
+        return -1;
+    if (pthread_mutex_init(&d->lock, NULL) != 0)
+    {
+        pthread_barrier_destroy(&d->barrier);
+        return -1;
+    }
+    if (pthread_cond_init(&d->gate, NULL) != 0)
+    {
+        pthread_mutex_destroy(&d->lock);
+        pthread_barrier_destroy(&d->barrier);
+        return -1;
+    }
+    for (p = 1; p < d->processes; p++)
+    {
+        d->thread[p].d = d;
+        d->thread[p].p = p;
+        if (pthread_create(&d->thread[p].id, NULL, Thread, &d->thread[p]) != 0)
+            break;
+    }
+    if (p < d->processes)
+    {
+        Release(d, -1, p);
+        return -1;
+    }
+    return 0;
+}
+
+static int Partition(pdes *d, int threads)
+{
+    /* -------------------------------------------------------------------------- *
+     * split the nodes in threads blocks of consecutive nodes with about the      *
+     * same flow of jobs (from the traffic equations); return the processes,      *
+     * the blocks that are not empty, or -1 if out of memory                      *
+     * -------------------------------------------------------------------------- */
+    const topology *t = d->s->top;
+    double *flow = calloc(t->nodes + 1, sizeof(double));
+    double *next = calloc(t->nodes + 1, sizeof(double));
+    double total = 0.0, sum = 0.0;
+    int processes = 0, last = -1;
+
+    if (flow == NULL || next == NULL)
+    {
+        free(flow);
+        free(next);
+        return -1;
+    }
+    for (int k = 0; k < 1000; k++)
+    { // flow = arrivals from outside + flow routed from the nodes
+        double change = 0.0;
+
+        for (int j = 0; j <= t->nodes; j++)
+            next[j] = 0.0;
+        for (int i = 0; i <= t->nodes; i++)
+        {
+            double from = (i == 0) ? 1.0 : flow[i];
+
+            for (int e = 0; e < Destinations(t->route, i); e++)
+            {
+                double p;
+                int j = RouteEntry(t->route, i, e, &p);
+
+                next[j] += from * p;
+            }
+        }
+        for (int j = 1; j <= t->nodes; j++)
+        {
+            change += fabs(next[j] - flow[j]);
+            flow[j] = next[j];
+        }
+        if (change < 1e-12)
+            break;
+    }
+    for (int i = 1; i <= t->nodes; i++)
+        total += flow[i] + 1e-9; // a node without flow still counts
+    for (int i = 1; i <= t->nodes; i++)
+    { // node i goes to the block of the middle of its flow
+        int b = (int)((sum + (flow[i] + 1e-9) / 2) / total * threads);
+
+        sum += flow[i] + 1e-9;
+        if (b != last)
+        {
+            d->lp[processes++].first = i;
+            last = b;
+        }
+        d->owner[i] = processes - 1;
+    }
+    for (int p = 0; p < processes; p++)
+        d->lp[p].last = (p + 1 < processes) ? d->lp[p + 1].first : t->nodes + 1;
+    free(flow);
+    free(next);
+    return processes;
+}
+
+static int Lookahead(pdes *d)
+{
+    /* -------------------------------------------------------------------------- *
+     * the minimum time from an event of each process to an arrival it sends to   *
+     * each other; return -1 if a job can cross with no lookahead                 *
+     * -------------------------------------------------------------------------- */
+    const topology *t = d->s->top;
+    int n = d->processes;
+
+    for (int k = 0; k < n * n; k++)
+        d->lookahead[k] = INFINITY;
+    for (int i = 1; i <= t->nodes; i++)
+    {
+        double min = Minimum(&t->service[t->group[i]]);
+
+        for (int e = 0; e < Destinations(t->route, i); e++)
+        {
+            double p;
+            int j = RouteEntry(t->route, i, e, &p);
+            int v = d->owner[i], w = (j > 0) ? d->owner[j] : v;
+
+            if (v == w)
+                continue;
+            if (!(min > 0.0))
+                return -1;
+            if (min < d->lookahead[v * n + w])
+                d->lookahead[v * n + w] = min;
+        }
+    }
+    return 0;
+}
+
+static void Streams(pdes *d)
+{
+    /* -------------------------------------------------------------------------- *
+     * the stream of each node, jumped from the stream of its group by the index  *
+     * of the node in the group                                                   *
+     * -------------------------------------------------------------------------- */
+    const topology *t = d->s->top;
+
+    for (int i = 1; i <= t->nodes; i++)
+    {
+        int g = t->group[i];
+        rng_stream *r = &d->node[i].r;
+        long long jump = NODE_JUMP;
+
+        *r = *d->s->service[g];
+        if (r->kind != RNG_MRG32K3A)
+            jump = 2147483646LL / STREAMS / t->count[g];
+        JumpStream(r, jump * (i - t->first[g]));
+    }
+}
+
+static long Outside(pdes *d, double *end)
+{
+    /* -------------------------------------------------------------------------- *
+     * the arrivals from outside up to STOP, the first one already drawn by       *
+     * InitSimulation(), given to the process of their node; return their         *
+     * number, -1 if out of memory                                                *
+     * -------------------------------------------------------------------------- */
+    sim_context *s = d->s;
+    rng_stream *route = StreamR(&s->rng, s->p.streams + s->top->groups);
+    queue *q = calloc(d->processes, sizeof(queue));
+    double t = s->arrival;
+    long count = 0;
+
+    if (q == NULL)
+        return -1;
+    while (t <= s->p.stop)
+    {
+        message m;
+
+        m.t = t;
+        m.node = Route(s->top->route, s->p.routing, 0, route);
+        m.from = 0;
+        if (Push(&q[d->owner[m.node]], m) != 0)
+            break;
+        count++;
+        t += SampleR(&s->interarrival, s->in);
+    }
+    *end = t;
+    for (int p = 0; p < d->processes; p++)
+    {
+        d->lp[p].outside = q[p].m;
+        d->lp[p].arrivals = q[p].n;
+    }
+    free(q);
+    return (t <= s->p.stop) ? -1 : count;
+}
+
+static void Finish(sim_context *s, pdes *d, long arrivals, double end)
+{
+    /* -------------------------------------------------------------------------- *
+     * the statistics of the nodes in s, as netsim.c leaves them at the end of a  *
+     * run with purge                                                             *
+     * -------------------------------------------------------------------------- */
+    for (int p = 0; p < d->processes; p++)
+    {
+        if (d->lp[p].current > s->current)
+            s->current = d->lp[p].current;
+    }
+    for (int i = 1; i <= s->top->nodes; i++)
+    {
+        station *x = &d->node[i];
+
+        s->statistics[i].service += x->sum.service;
+        s->statistics[i].served += x->sum.served;
+        s->statistics[i].arrives += x->sum.arrives;
+        s->area[i - 1] += x->area;
+        s->number[i - 1] = 0;
+        s->changed[i - 1] = s->current;
+        s->departures += x->left;
+        s->refused += x->refused;
+    }
+    s->arrivals += arrivals;
+    s->jobs = 0;
+    s->next = s->current;
+    s->arrival = end;
+    ClearEvents(s->event);
+    ScheduleEvent(s->event, 0, end);
+    CancelEvent(s->event, 0);
+}
+
+static void FreePdes(pdes *d)
+{
+    for (int p = 0; d->lp != NULL && p < d->processes; p++)
+    {
+        FreeEventList(d->lp[p].event);
+        free(d->lp[p].in.m);
+        free(d->lp[p].outside);
+    }
+    for (int k = 0; d->box != NULL && k < d->processes * d->processes; k++)
+        free(d->box[k].m);
+    free(d->lp);
+    free(d->owner);
+    free(d->node);
+    free(d->lookahead);
+    free(d->box);
+    free(d->thread);
+}
+
+int RunParallelSimulation(sim_context *s, int threads, long *rounds)
+{
+    /* -------------------------------------------------------------------------- *
+     * run s from its initial state on threads threads (0 for all the cores), as  *
+     * RunSimulation() with purge; return 0, 1 if the run is not for this         *
+     * library (s is not changed), -1 if out of memory; rounds (if not NULL) is   *
+     * the number of rounds of synchronization                                    *
+     * -------------------------------------------------------------------------- */
+    int nodes = s->top->nodes;
+    long arrivals;
+    double end;
+    pdes d;
+    int error;
+
+    if (s->p.purge != 1 || s->p.departures > 0 ||
+        s->p.streams + s->top->groups >= STREAMS ||
+        RouteProbability(s->top->route, 0, 0) > 0.0)
+        return 1;
+    if (threads < 1)
+        threads = DefaultThreads();
+    if (threads > nodes)
+        threads = nodes;
+    d.s = s;
+    d.lp = calloc(threads, sizeof(process));
+    d.owner = calloc(nodes + 1, sizeof(int));
+    d.node = calloc(nodes + 1, sizeof(station));
+    d.lookahead = NULL;
+    d.box = NULL;
+    d.thread = NULL;
+    d.processes = 0;
+    if (d.lp == NULL || d.owner == NULL || d.node == NULL ||
+        (d.processes = Partition(&d, threads)) < 0)
+    {
+        d.processes = 0;
+        FreePdes(&d);
+        return -1;
+    }
+    d.lookahead = malloc(d.processes * d.processes * sizeof(double));
+    d.box = calloc(d.processes * d.processes, sizeof(queue));
+    if (d.lookahead == NULL || d.box == NULL)
+    {
+        FreePdes(&d);
+        return -1;
+    }
+    if (Lookahead(&d) != 0 || Launch(&d) != 0)
+    { // no lookahead, or no barrier or threads: left to netsim.c
+        FreePdes(&d);
+        return 1;
+    }
+
+    error = 0;
+    for (int p = 0; p < d.processes && !error; p++)
+    {
+        process *lp = &d.lp[p];
+
+        lp->event = CreateEventList(EVENT_HEAP, lp->last - lp->first);
+        error = (lp->event == NULL);
+    }
+    Streams(&d);
+    arrivals = error ? -1 : Outside(&d, &end);
+    if (arrivals < 0)
+    {
+        Release(&d, -1, d.processes);
+        FreePdes(&d);
+        return -1;
+    }
+    d.done = 0;
+    d.rounds = 0;
+    Release(&d, 1, d.processes);
+    for (int p = 0; p < d.processes; p++)
+        error |= (d.lp[p].error != 0);
+    if (!error)
+        Finish(s, &d, arrivals, end);
+    if (rounds != NULL)
+        *rounds = d.rounds;
+    FreePdes(&d);
+    return error ? -1 : 0;
+}
@@ -0,0 +1,15 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : pdes.h  (header file for the library pdes.c)             *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_PDES_)
+#define _PDES_
+
+#include "netsim.h"
+
+int RunParallelSimulation(sim_context *s, int threads, long *rounds);
+
+#endif
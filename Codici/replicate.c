@@ -0,0 +1,252 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library that runs the replications 0, 1, ..., n - 1 of a        *
+ * simulation on a pool of threads. Every thread takes the next replication   *
+ * not yet started, so long and short replications are balanced between the  *
+ * threads. The worker index (0 <= worker < threads) passed to the body can   *
+ * be used to reuse per-thread memory, such as a sim_context (netsim.h).      *
+ *                                                                            *
+ * The order in which replications run depends on the scheduling of the      *
+ * threads: to get results that do not depend on the number of threads, the  *
+ * body of replication r must depend only on r (for example its streams      *
+ * planted with PlantReplicationR, see rngs.c) and store its output at        *
+ * position r, to be printed once all the replications are over.             *
+ *                                                                            *
+ * RunTasks() runs independent tasks of very different lengths, such as the   *
+ * points of a parameter sweep, with work stealing: the tasks are dealt       *
+ * round-robin to per-thread deques, every thread takes its own tasks from    *
+ * the bottom of its deque and, once it is empty, steals from the top of the  *
+ * deque of another thread, so a thread left with long tasks is helped by     *
+ * the others without a shared queue on the common path.                      *
+ *                                                                            *
+ * Name            : replicate.c  (Parallel Replications)                     *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "replicate.h"
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    long next; // next replication to start
+    long n;    // number of replications
+    replication body;
+    void *arg;
+} pool;
+
+typedef struct
+{
+    pool *p;
+    int worker;
+} worker_arg;
+
+int DefaultThreads(void)
+{
+    /* -------------------------------------------------------------------------- *
+     * return the number of cores available                                       *
+     * -------------------------------------------------------------------------- */
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+static void *Worker(void *arg)
+{
+    worker_arg *w = arg;
+    pool *p = w->p;
+
+    for (;;)
+    {
+        long r;
+
+        pthread_mutex_lock(&p->lock);
+        r = p->next++;
+        pthread_mutex_unlock(&p->lock);
+        if (r >= p->n)
+            break;
+        p->body(r, w->worker, p->arg);
+    }
+    return NULL;
+}
+
+static int StartThreads(int threads, void *(*run)(void *), void *args,
+                        size_t size, pthread_t *tid)
+{
+    /* -------------------------------------------------------------------------- *
+     * start workers 1, 2, ..., threads - 1 and run worker 0 in the calling       *
+     * thread; return the number of threads to join                               *
+     * -------------------------------------------------------------------------- */
+    int started = 0;
+
+    for (int i = 1; i < threads; i++)
+    {
+        if (pthread_create(&tid[i], NULL, run, (char *)args + i * size) != 0)
+            break;
+        started = i;
+    }
+    run(args);
+    for (int i = 1; i <= started; i++)
+        pthread_join(tid[i], NULL);
+    return started;
+}
+
+int RunReplications(long n, int threads, replication body, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * run body(r, worker, arg) for r = 0, 1, ..., n - 1 on threads threads,      *
+     * return 0 on success                                                        *
+     * -------------------------------------------------------------------------- */
+    pool p;
+    pthread_t *tid;
+    worker_arg *w;
+
+    if (threads < 1)
+        threads = DefaultThreads();
+    if (threads > n)
+        threads = (n > 0) ? (int)n : 1;
+
+    p.next = 0;
+    p.n = n;
+    p.body = body;
+    p.arg = arg;
+    pthread_mutex_init(&p.lock, NULL);
+
+    tid = malloc(threads * sizeof(pthread_t));
+    w = malloc(threads * sizeof(worker_arg));
+    if (tid == NULL || w == NULL)
+    {
+        free(tid);
+        free(w);
+        pthread_mutex_destroy(&p.lock);
+        return -1;
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        w[i].p = &p;
+        w[i].worker = i;
+    }
+    StartThreads(threads, Worker, w, sizeof(worker_arg), tid);
+
+    pthread_mutex_destroy(&p.lock);
+    free(tid);
+    free(w);
+    return 0;
+}
+
+/* ------------------------------- Work stealing ---------------------------- */
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    long *task; // tasks of the thread
+    long top;   // first task not yet taken (thieves)
+    long bottom; // one past the last task not yet taken (owner)
+} deque;
+
+typedef struct
+{
+    deque *d;
+    int threads;
+    int worker;
+    replication body;
+    void *arg;
+} thief;
+
+static long Pop(deque *d)
+{
+    long r = -1;
+
+    pthread_mutex_lock(&d->lock);
+    if (d->top < d->bottom)
+        r = d->task[--d->bottom];
+    pthread_mutex_unlock(&d->lock);
+    return r;
+}
+
+static long Steal(deque *d)
+{
+    long r = -1;
+
+    pthread_mutex_lock(&d->lock);
+    if (d->top < d->bottom)
+        r = d->task[d->top++];
+    pthread_mutex_unlock(&d->lock);
+    return r;
+}
+
+static void *Stealer(void *arg)
+{
+    thief *t = arg;
+
+    for (;;)
+    {
+        long r = Pop(&t->d[t->worker]);
+
+        for (int k = 1; r < 0 && k < t->threads; k++)
+            r = Steal(&t->d[(t->worker + k) % t->threads]);
+        if (r < 0)
+            break; // no task is left anywhere: they are never created
+        t->body(r, t->worker, t->arg);
+    }
+    return NULL;
+}
+
+int RunTasks(long n, int threads, replication body, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * run body(r, worker, arg) for r = 0, 1, ..., n - 1 with work stealing,      *
+     * return 0 on success                                                        *
+     * -------------------------------------------------------------------------- */
+    pthread_t *tid;
+    deque *d;
+    thief *t;
+    long *task;
+
+    if (threads < 1)
+        threads = DefaultThreads();
+    if (threads > n)
+        threads = (n > 0) ? (int)n : 1;
+
+    tid = malloc(threads * sizeof(pthread_t));
+    d = malloc(threads * sizeof(deque));
+    t = malloc(threads * sizeof(thief));
+    task = malloc((n > 0 ? n : 1) * sizeof(long));
+    if (tid == NULL || d == NULL || t == NULL || task == NULL)
+    {
+        free(tid);
+        free(d);
+        free(t);
+        free(task);
+        return -1;
+    }
+
+    for (int i = 0; i < threads; i++)
+    { // tasks i, i + threads, i + 2 * threads, ... in reverse order, so that
+      // the owner starts from the first one
+        long count = (n - i + threads - 1) / threads;
+
+        d[i].task = task + (n / threads) * i + (i < n % threads ? i : n % threads);
+        d[i].top = 0;
+        d[i].bottom = count;
+        for (long k = 0; k < count; k++)
+            d[i].task[count - 1 - k] = i + k * threads;
+        pthread_mutex_init(&d[i].lock, NULL);
+        t[i].d = d;
+        t[i].threads = threads;
+        t[i].worker = i;
+        t[i].body = body;
+        t[i].arg = arg;
+    }
+    StartThreads(threads, Stealer, t, sizeof(thief), tid);
+
+    for (int i = 0; i < threads; i++)
+        pthread_mutex_destroy(&d[i].lock);
+    free(tid);
+    free(d);
+    free(t);
+    free(task);
+    return 0;
+}
@@ -0,0 +1,18 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : replicate.h  (header file for the library replicate.c)   *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_REPLICATE_)
+#define _REPLICATE_
+
+// body of a replication: r is the replication, worker the thread running it
+typedef void (*replication)(long r, int worker, void *arg);
+
+int DefaultThreads(void);
+int RunReplications(long n, int threads, replication body, void *arg);
+int RunTasks(long n, int threads, replication body, void *arg);
+
+#endif
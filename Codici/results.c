@@ -0,0 +1,275 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library for the results of the simulations in a binary file, by  *
+ * columns, instead of text printed with %f: the values are stored as they   *
+ * are (no digits lost), with the configuration of the run that made them,    *
+ * and a program reads them straight from the file mapped in memory, without  *
+ * parsing and without copying them.                                          *
+ *                                                                            *
+ * The layout of a file (native byte order, checked by the reader) is         *
+ *                                                                            *
+ *      offset  0  "PMCSNRES"            magic                                *
+ *              8  uint32 version        1                                    *
+ *             12  uint32 order          0x01020304, as written               *
+ *             16  uint64 rows                                                *
+ *             24  uint32 columns                                             *
+ *             28  uint32 text           bytes of the text, a multiple of 8   *
+ *             32  metadata '\0' name 1 '\0' ... name columns '\0' (padding)  *
+ *      32 + text  column 1: rows doubles, then column 2, ...                 *
+ *                                                                            *
+ * so every column is an array of doubles aligned in memory. The metadata is  *
+ * free text: simulate writes there its configuration, in the format of a     *
+ * configuration file (see config.c), so that the run can be repeated.        *
+ * A writer keeps the columns in memory and writes the file at the end, with  *
+ * SaveResults(); missing values (such as the batches of a run ended before   *
+ * STOP) are NAN.                                                              *
+ *                                                                            *
+ * Name            : results.c  (Binary Result Files)                         *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "results.h"
+
+#define MAGIC "PMCSNRES"
+#define VERSION 1
+#define ORDER 0x01020304
+#define HEADER 32 /* bytes before the text */
+
+struct results
+{
+    char *path;
+    int columns;
+    char *text;      // metadata and names, as in the file
+    uint32_t length; // bytes of text, padded
+    long rows;       // rows written
+    long size;       // rows allocated
+    double **column;
+};
+
+results *CreateResults(const char *path, int columns,
+                       const char *const *names, const char *meta)
+{
+    /* -------------------------------------------------------------------------- *
+     * a new result file of columns columns, written by SaveResults()             *
+     * -------------------------------------------------------------------------- */
+    results *r = calloc(1, sizeof(results));
+    size_t length;
+    char *t;
+
+    if (r == NULL)
+        return NULL;
+    if (meta == NULL)
+        meta = "";
+    length = strlen(meta) + 1;
+    for (int c = 0; c < columns; c++)
+        length += strlen(names[c]) + 1;
+    length = (length + 7) & ~(size_t)7;
+    r->path = malloc(strlen(path) + 1);
+    r->text = calloc(length, 1);
+    r->column = calloc(columns, sizeof(double *));
+    if (r->path == NULL || r->text == NULL || r->column == NULL ||
+        length > UINT32_MAX)
+    {
+        free(r->path);
+        free(r->text);
+        free(r->column);
+        free(r);
+        return NULL;
+    }
+    strcpy(r->path, path);
+    t = stpcpy(r->text, meta) + 1;
+    for (int c = 0; c < columns; c++)
+        t = stpcpy(t, names[c]) + 1;
+    r->length = (uint32_t)length;
+    r->columns = columns;
+    return (r);
+}
+
+int PutResult(results *r, long row, int column, double x)
+{
+    /* -------------------------------------------------------------------------- *
+     * the value of a row and column, return -1 if out of memory                  *
+     * -------------------------------------------------------------------------- */
+    if (column < 0 || column >= r->columns || row < 0)
+        return -1;
+    if (row >= r->size)
+    {
+        long size = (r->size > 0) ? 2 * r->size : 1024;
+
+        while (size <= row)
+            size *= 2;
+        for (int c = 0; c < r->columns; c++)
+        {
+            double *p = realloc(r->column[c], size * sizeof(double));
+
+            if (p == NULL)
+                return -1;
+            for (long i = r->size; i < size; i++)
+                p[i] = NAN;
+            r->column[c] = p;
+        }
+        r->size = size;
+    }
+    r->column[column][row] = x;
+    if (row >= r->rows)
+        r->rows = row + 1;
+    return 0;
+}
+
+int SaveResults(results *r)
+{
+    /* -------------------------------------------------------------------------- *
+     * write the file and free the writer, return 0 on success                    *
+     * -------------------------------------------------------------------------- */
+    unsigned char header[HEADER];
+    uint32_t u;
+    uint64_t rows = r->rows;
+    int error;
+    FILE *f = fopen(r->path, "wb");
+
+    memcpy(header, MAGIC, 8);
+    u = VERSION;
+    memcpy(header + 8, &u, 4);
+    u = ORDER;
+    memcpy(header + 12, &u, 4);
+    memcpy(header + 16, &rows, 8);
+    u = r->columns;
+    memcpy(header + 24, &u, 4);
+    memcpy(header + 28, &r->length, 4);
+
+    error = (f == NULL || fwrite(header, HEADER, 1, f) != 1 ||
+             fwrite(r->text, r->length, 1, f) != 1);
+    for (int c = 0; c < r->columns && !error && r->rows > 0; c++)
+        error = (fwrite(r->column[c], sizeof(double), r->rows, f) !=
+                 (size_t)r->rows);
+    if (f != NULL && fclose(f) != 0)
+        error = 1;
+
+    for (int c = 0; c < r->columns; c++)
+        free(r->column[c]);
+    free(r->column);
+    free(r->text);
+    free(r->path);
+    free(r);
+    return error ? -1 : 0;
+}
+
+int IsResults(const void *data, size_t size)
+{
+    return (size >= HEADER && memcmp(data, MAGIC, 8) == 0);
+}
+
+int ViewResults(result_file *f, const void *data, size_t size)
+{
+    /* -------------------------------------------------------------------------- *
+     * read the result file in data[0..size - 1] without copying it; return -1   *
+     * if it is not a valid result file of this machine; free f->name at the end  *
+     * -------------------------------------------------------------------------- */
+    const char *p = data;
+    uint32_t version, order, columns, length;
+    uint64_t rows;
+    const char *t;
+
+    memset(f, 0, sizeof(result_file));
+    if (!IsResults(data, size))
+        return -1;
+    memcpy(&version, p + 8, 4);
+    memcpy(&order, p + 12, 4);
+    memcpy(&rows, p + 16, 8);
+    memcpy(&columns, p + 24, 4);
+    memcpy(&length, p + 28, 4);
+    if (version != VERSION || order != ORDER || length == 0 || length % 8 != 0 ||
+        size < HEADER + (uint64_t)length ||
+        (size - HEADER - length) / sizeof(double) / (columns ? columns : 1) <
+            rows ||
+        p[HEADER + length - 1] != '\0')
+        return -1;
+    if ((f->name = malloc((columns + 1) * sizeof(const char *))) == NULL)
+        return -1;
+    t = p + HEADER;
+    f->meta = t;
+    for (uint32_t c = 0; c < columns; c++)
+    {
+        t += strlen(t) + 1;
+        if (t >= p + HEADER + length)
+        {
+            free(f->name);
+            f->name = NULL;
+            return -1;
+        }
+        f->name[c] = t;
+    }
+    f->rows = (long)rows;
+    f->columns = (int)columns;
+    f->data = (const double *)(p + HEADER + length);
+    return 0;
+}
+
+result_file *MapResults(const char *path)
+{
+    /* -------------------------------------------------------------------------- *
+     * map a result file in memory, NULL if it cannot be read or is not valid     *
+     * -------------------------------------------------------------------------- */
+    result_file *f = malloc(sizeof(result_file));
+    struct stat st;
+    void *map;
+    int fd;
+
+    if (f == NULL)
+        return NULL;
+    if ((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &st) != 0 ||
+        st.st_size < HEADER ||
+        (map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) ==
+            MAP_FAILED)
+    {
+        if (fd >= 0)
+            close(fd);
+        free(f);
+        return NULL;
+    }
+    close(fd);
+    if (ViewResults(f, map, st.st_size) != 0)
+    {
+        munmap(map, st.st_size);
+        free(f);
+        return NULL;
+    }
+    f->map = map;
+    f->size = st.st_size;
+    return (f);
+}
+
+void UnmapResults(result_file *f)
+{
+    if (f == NULL)
+        return;
+    if (f->map != NULL)
+        munmap(f->map, f->size);
+    free(f->name);
+    free(f);
+}
+
+const double *ResultColumn(const result_file *f, int column)
+{
+    return f->data + (size_t)column * f->rows;
+}
+
+int FindColumn(const result_file *f, const char *name)
+{
+    for (int c = 0; c < f->columns; c++)
+    {
+        if (strcmp(f->name[c], name) == 0)
+            return c;
+    }
+    return -1;
+}
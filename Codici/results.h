@@ -0,0 +1,39 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : results.h  (header file for the library results.c)       *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_RESULTS_)
+#define _RESULTS_
+
+#include <stddef.h>
+
+typedef struct results results; // a result file being written
+
+// A result file read in memory
+typedef struct
+{
+    long rows;
+    int columns;
+    const char *meta;    // metadata: the configuration of the run
+    const char **name;   // name of each column
+    const double *data;  // column c: data[c * rows], ..., NAN if missing
+    void *map;           // the mapping of MapResults(), else NULL
+    size_t size;         //   and its size
+} result_file;
+
+results *CreateResults(const char *path, int columns,
+                       const char *const *names, const char *meta);
+int PutResult(results *r, long row, int column, double x);
+int SaveResults(results *r);
+
+int IsResults(const void *data, size_t size);
+int ViewResults(result_file *f, const void *data, size_t size);
+result_file *MapResults(const char *path);
+void UnmapResults(result_file *f);
+const double *ResultColumn(const result_file *f, int column);
+int FindColumn(const result_file *f, const char *name);
+
+#endif
@@ -0,0 +1,136 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library of rings of times between two threads, one that writes   *
+ * (the producer) and one that reads (the consumer), without locks: the       *
+ * producer only moves the tail and the consumer only moves the head, each    *
+ * with a release store seen by the other with an acquire load, so the times  *
+ * written before a tail are always visible to the consumer that reads it.    *
+ * Head and tail lie on different cache lines, so the two threads do not      *
+ * invalidate each other at every access.                                     *
+ *                                                                            *
+ * PutRing() and GetRing() never wait: they move as many times as there are   *
+ * room or times for, possibly none, and the caller decides what to do in     *
+ * the meantime (see lindley.c). The producer closes the ring at the end of   *
+ * its stream, and GetRing() returns -1 once the ring is closed and empty.    *
+ * The cost of the rings against a single thread has only been measured on    *
+ * one core (see lindley.c): the gain of the threads is not validated.        *
+ *                                                                            *
+ * Name            : ring.c  (Single-Producer Single-Consumer Ring)           *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "ring.h"
+
+#define LINE 64 /* bytes of a cache line */
+
+struct ring
+{
+    _Alignas(LINE) atomic_long head; // next time to read
+    _Alignas(LINE) atomic_long tail; // next time to write
+    atomic_int closed;               // no more times will be written
+    _Alignas(LINE) long size;        // a power of 2
+    double *x;
+};
+
+ring *CreateRing(long size)
+{
+    /* -------------------------------------------------------------------------- *
+     * an empty ring of at least size times                                       *
+     * -------------------------------------------------------------------------- */
+    ring *r = aligned_alloc(LINE, sizeof(ring));
+    long n = 1;
+
+    if (r == NULL)
+        return NULL;
+    while (n < size)
+        n *= 2;
+    r->size = n;
+    r->x = malloc(n * sizeof(double));
+    if (r->x == NULL)
+    {
+        free(r);
+        return NULL;
+    }
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    atomic_init(&r->closed, 0);
+    return (r);
+}
+
+void FreeRing(ring *r)
+{
+    if (r != NULL)
+        free(r->x);
+    free(r);
+}
+
+static void Copy(double *to, long at, const double *from, long n, long size,
+                 int in)
+{
+    /* -------------------------------------------------------------------------- *
+     * copy n times into (in) or out of the ring buffer, from position at         *
+     * -------------------------------------------------------------------------- */
+    long i = at & (size - 1);
+    long k = (n < size - i) ? n : size - i; // before the end of the buffer
+
+    if (in)
+    {
+        memcpy(to + i, from, k * sizeof(double));
+        memcpy(to, from + k, (n - k) * sizeof(double));
+    }
+    else
+    {
+        memcpy(to, from + i, k * sizeof(double));
+        memcpy(to + k, from, (n - k) * sizeof(double));
+    }
+}
+
+long PutRing(ring *r, const double *x, long n)
+{
+    /* -------------------------------------------------------------------------- *
+     * producer: write up to n times of x, return how many                        *
+     * -------------------------------------------------------------------------- */
+    long tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    long head = atomic_load_explicit(&r->head, memory_order_acquire);
+    long room = r->size - (tail - head);
+
+    if (n > room)
+        n = room;
+    if (n > 0)
+    {
+        Copy(r->x, tail, x, n, r->size, 1);
+        atomic_store_explicit(&r->tail, tail + n, memory_order_release);
+    }
+    return n;
+}
+
+long GetRing(ring *r, double *x, long n)
+{
+    /* -------------------------------------------------------------------------- *
+     * consumer: read up to n times into x, return how many, -1 if the ring is    *
+     * closed and there are no more                                               *
+     * -------------------------------------------------------------------------- */
+    int closed = atomic_load_explicit(&r->closed, memory_order_acquire);
+    long head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    long tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+
+    if (tail == head)
+        return closed ? -1 : 0; // if closed, tail was the last before it
+    if (n > tail - head)
+        n = tail - head;
+    Copy(x, head, r->x, n, r->size, 0);
+    atomic_store_explicit(&r->head, head + n, memory_order_release);
+    return n;
+}
+
+void CloseRing(ring *r)
+{
+    /* -------------------------------------------------------------------------- *
+     * producer: the stream is over                                               *
+     * -------------------------------------------------------------------------- */
+    atomic_store_explicit(&r->closed, 1, memory_order_release);
+}
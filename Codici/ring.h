@@ -0,0 +1,19 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : ring.h  (header file for the library ring.c)             *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_RING_)
+#define _RING_
+
+typedef struct ring ring;
+
+ring *CreateRing(long size);
+void FreeRing(ring *r);
+long PutRing(ring *r, const double *x, long n);
+long GetRing(ring *r, double *x, long n);
+void CloseRing(ring *r);
+
+#endif
@@ -25,6 +25,40 @@
  *                   Steve Park and Keith Miller
  *              Communications of the ACM, October 1988
  *
+ * Every function has a reentrant version, with the R suffix, that works on
+ * a set of streams (rngs_state) passed explicitly: simulations that own
+ * their rngs_state can run at the same time in the same process.
+ * RandomR() itself draws from a stream handle (rng_stream), given by
+ * StreamR(g, s) once and for all: a simulation keeps one handle for each
+ * purpose and never selects a stream, and RandomR(), defined inline in
+ * rngs.h, updates only the state of that stream. The original functions,
+ * Random() and SelectStream(), remain on top of the handles.
+ *
+ * RandomFill(s, out, n) fills out[] with the next n random numbers of
+ * stream s, exactly the ones n calls to Random() would return, without
+ * selecting the stream. It advances LANES copies of the generator, each
+ * LANES steps at a time (jump multiplier MULTIPLIER^LANES mod MODULUS),
+ * with the product reduced modulo 2^31 - 1 without division: the
+ * independent lanes are computed by the SIMD instructions of the CPU.
+ *
+ * With SetGenerator(RNG_MRG32K3A) before PlantSeeds() the streams use the
+ * combined multiple recursive generator MRG32k3a instead:
+ *
+ *       "Good Parameters and Implementations for Combined Multiple
+ *                   Recursive Random Number Generators"
+ *                          Pierre L'Ecuyer
+ *              Operations Research, January-February 1999
+ *
+ * Its period is about 2^191; as in the RngStreams package, the streams
+ * start 2^127 draws apart and each stream is cut in substreams of 2^76
+ * draws. PlantReplicationR() gives replication r substream r of every
+ * stream, so replications never overlap for any practical count, while
+ * with the Lehmer generator the period 2^31 - 2 is shared among all of
+ * them. Jumps are powers of the 3x3 transition matrices of the two
+ * components, computed by squaring in O(log n) steps. Random numbers of
+ * MRG32k3a are not the same as the Lehmer ones: the default RNG_LEHMER
+ * reproduces the original results.
+ *
  * Name            : rngs.c  (Random Number Generation - Multiple Streams)
  * Authors         : Steve Park & Dave Geyer
  * Language        : ANSI C
@@ -33,42 +67,236 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <time.h>
 #include "rngs.h"
 
 #define MODULUS    2147483647 /* DON'T CHANGE THIS VALUE                  */
 #define MULTIPLIER 48271      /* DON'T CHANGE THIS VALUE                  */
 #define CHECK      399268537  /* DON'T CHANGE THIS VALUE                  */
-#define STREAMS    256        /* # of streams, DON'T CHANGE THIS VALUE    */
 #define A256       22925      /* jump multiplier, DON'T CHANGE THIS VALUE */
 #define DEFAULT    123456789  /* initial seed, use 0 < DEFAULT < MODULUS  */
-      
-static long seed[STREAMS] = {DEFAULT};  /* current state of each stream   */
-static int  stream        = 0;          /* stream index, 0 is the default */
-static int  initialized   = 0;          /* test for stream initialization */
+#define LANES      8          /* generators advanced together by RandomFill */
 
+#define M1         4294967087LL /* MRG32k3a, DON'T CHANGE THESE VALUES    */
+#define M2         4294944443LL
+#define A12        1403580LL
+#define A13N       810728LL
+#define A21        527612LL
+#define A23N       1370589LL
+#define NORM       2.328306549295727688e-10  /* 1 / (M1 + 1)              */
+#define STREAM_LOG 127        /* streams are 2^127 draws apart            */
+#define SUB_LOG    76         /* substreams are 2^76 draws apart          */
 
-   double Random(void)
+typedef unsigned long long mrg_matrix[3][3];
+
+static const mrg_matrix A1 = {{0, 1, 0}, {0, 0, 1}, {M1 - A13N, A12, 0}};
+static const mrg_matrix A2 = {{0, 1, 0}, {0, 0, 1}, {M2 - A23N, 0, A21}};
+
+static rngs_state global = {{{DEFAULT}}, 0, 0};  /* used by the functions   */
+                                               /* without the R suffix    */
+
+   static unsigned int MulMod(unsigned int x, unsigned int a)
+/* ------------------------------------------------------------------
+ * x * a mod MODULUS for 0 < x, a < MODULUS, since 2^31 = 1 mod MODULUS
+ * ------------------------------------------------------------------
+ */
+{
+  unsigned long long p = (unsigned long long) x * a;
+  unsigned int       y = (unsigned int) (p & MODULUS) + (unsigned int) (p >> 31);
+
+  return (y >= MODULUS ? y - MODULUS : y);
+}
+
+
+   double RandomMRG(rng_stream *s)
 /* ----------------------------------------------------------------
- * Random returns a pseudo-random real number uniformly distributed 
- * between 0.0 and 1.0. 
+ * RandomMRG returns the next random number of an MRG32k3a stream,
+ * in the open interval (0.0, 1.0); RandomR() calls it.
  * ----------------------------------------------------------------
  */
 {
-  const long Q = MODULUS / MULTIPLIER;
-  const long R = MODULUS % MULTIPLIER;
-        long t;
+  long long p1, p2;
 
-  t = MULTIPLIER * (seed[stream] % Q) - R * (seed[stream] / Q);
-  if (t > 0) 
-    seed[stream] = t;
-  else 
-    seed[stream] = t + MODULUS;
-  return ((double) seed[stream] / MODULUS);
+  p1 = (A12 * s->s[1] - A13N * s->s[0]) % M1;
+  if (p1 < 0)
+    p1 += M1;
+  s->s[0] = s->s[1];
+  s->s[1] = s->s[2];
+  s->s[2] = p1;
+  p2 = (A21 * s->s[5] - A23N * s->s[3]) % M2;
+  if (p2 < 0)
+    p2 += M2;
+  s->s[3] = s->s[4];
+  s->s[4] = s->s[5];
+  s->s[5] = p2;
+  return ((p1 > p2) ? (p1 - p2) * NORM : (p1 - p2 + M1) * NORM);
 }
 
 
-   void PlantSeeds(long x)
+   static void MatMul(const mrg_matrix a, const mrg_matrix b, mrg_matrix c,
+                      unsigned long long m)
+/* ------------------------------------------------------------------
+ * c = a * b mod m, the entries are less than m < 2^32 (c can be a)
+ * ------------------------------------------------------------------
+ */
+{
+  mrg_matrix t;
+  int        i, j, k;
+
+  for (i = 0; i < 3; i++)
+    for (j = 0; j < 3; j++) {
+      t[i][j] = 0;
+      for (k = 0; k < 3; k++)
+        t[i][j] = (t[i][j] + a[i][k] * b[k][j] % m) % m;
+    }
+  for (i = 0; i < 3; i++)
+    for (j = 0; j < 3; j++)
+      c[i][j] = t[i][j];
+}
+
+
+   static void MatPow(const mrg_matrix a, unsigned long long n, int e,
+                      mrg_matrix c, unsigned long long m)
+/* ------------------------------------------------------------------
+ * c = (a^(2^e))^n mod m: e squarings, then O(log n) products
+ * ------------------------------------------------------------------
+ */
+{
+  mrg_matrix p;
+  int        i, j;
+
+  for (i = 0; i < 3; i++)
+    for (j = 0; j < 3; j++) {
+      p[i][j] = a[i][j];
+      c[i][j] = (i == j);
+    }
+  for (i = 0; i < e; i++)
+    MatMul(p, p, p, m);
+  while (n > 0) {
+    if (n & 1)
+      MatMul(p, c, c, m);
+    MatMul(p, p, p, m);
+    n >>= 1;
+  }
+}
+
+
+   static void MatVec(const mrg_matrix a, long long *v, unsigned long long m)
+/* ------------------------------------------------------------------
+ * v = a * v mod m
+ * ------------------------------------------------------------------
+ */
+{
+  unsigned long long t[3];
+  int                i, k;
+
+  for (i = 0; i < 3; i++) {
+    t[i] = 0;
+    for (k = 0; k < 3; k++)
+      t[i] = (t[i] + a[i][k] * (unsigned long long) v[k] % m) % m;
+  }
+  for (i = 0; i < 3; i++)
+    v[i] = (long long) t[i];
+}
+
+
+   static void Jump(long long *v, unsigned long long n, int e)
+/* ------------------------------------------------------------------
+ * advance the MRG32k3a state v by n * 2^e draws
+ * ------------------------------------------------------------------
+ */
+{
+  mrg_matrix c;
+
+  MatPow(A1, n, e, c, M1);
+  MatVec(c, v, M1);
+  MatPow(A2, n, e, c, M2);
+  MatVec(c, v + 3, M2);
+}
+
+
+   static void PlantMRG(rngs_state *g, long x, long r)
+/* ------------------------------------------------------------------
+ * plant all the streams of g with MRG32k3a: the first stream starts
+ * from the state (x, x, x, x, x, x), jumped to its substream r, and
+ * each of the other streams 2^127 draws after the previous one
+ * ------------------------------------------------------------------
+ */
+{
+  mrg_matrix b1, b2;
+  long long  v[6];
+  int        j;
+
+  for (j = 0; j < 6; j++)                 /* 0 < x < MODULUS < M2 < M1 */
+    v[j] = x;
+  Jump(v, (unsigned long long) r, SUB_LOG);
+  MatPow(A1, 1, STREAM_LOG, b1, M1);
+  MatPow(A2, 1, STREAM_LOG, b2, M2);
+  for (j = 0; j < STREAMS; j++) {
+    int k;
+
+    for (k = 0; k < 6; k++)
+      g->stream[j].s[k] = v[k];
+    g->stream[j].seed = x;
+    g->stream[j].kind = RNG_MRG32K3A;
+    MatVec(b1, v, M1);
+    MatVec(b2, v + 3, M2);
+  }
+}
+
+
+   void JumpStream(rng_stream *s, long long n)
+/* ------------------------------------------------------------------
+ * Use this function to advance stream s by n draws in O(log n) steps,
+ * with either generator.
+ * ------------------------------------------------------------------
+ */
+{
+  if (s->kind == RNG_MRG32K3A)
+    Jump(s->s, (unsigned long long) n, 0);
+  else
+    s->seed = JumpSeed(s->seed, (long) (n % (MODULUS - 1)));
+}
+
+
+   void RandomFillR(rng_stream *s, double *out, long n)
+/* ----------------------------------------------------------------
+ * RandomFill stores in out[0], ..., out[n - 1] the next n random
+ * numbers of stream s, the same of n calls to RandomR(s).
+ * ----------------------------------------------------------------
+ */
+{
+  unsigned int x[LANES];
+  unsigned int jump = (unsigned int) JumpSeed(1, LANES);
+  unsigned int last = (unsigned int) s->seed;
+  long         i    = 0;
+  int          j;
+
+  if (s->kind == RNG_MRG32K3A) {
+    for (; i < n; i++)
+      out[i] = RandomMRG(s);
+    return;
+  }
+  if (n <= 0)
+    return;
+  x[0] = MulMod(last, MULTIPLIER);              /* lane j is j + 1 steps */
+  for (j = 1; j < LANES; j++)                   /* ahead of the state    */
+    x[j] = MulMod(x[j - 1], MULTIPLIER);
+  for (; i + LANES <= n; i += LANES) {
+    last = x[LANES - 1];
+    for (j = 0; j < LANES; j++) {
+      out[i + j] = (double) (int) x[j] / MODULUS;
+      x[j]       = MulMod(x[j], jump);
+    }
+  }
+  for (j = 0; i < n; i++, j++)                  /* the last n % LANES    */
+    out[i] = (double) (int) (last = x[j]) / MODULUS;
+  s->seed = (long) last;
+}
+
+
+   void PlantSeedsR(rngs_state *g, long x)
 /* ---------------------------------------------------------------------
  * Use this function to set the state of all the random number generator 
  * streams by "planting" a sequence of states (seeds), one per stream, 
@@ -83,22 +311,28 @@ static int  initialized   = 0;          /* test for stream initialization */
         int  j;
         int  s;
 
-  initialized = 1;
-  s = stream;                            /* remember the current stream */
-  SelectStream(0);                       /* change to stream 0          */
-  PutSeed(x);                            /* set seed[0]                 */
-  stream = s;                            /* reset the current stream    */
+  g->initialized = 1;
+  s = g->current;                        /* remember the current stream */
+  SelectStreamR(g, 0);                   /* change to stream 0          */
+  PutSeedR(g, x);                        /* set seed[0]                 */
+  g->current = s;                        /* reset the current stream    */
+  if (g->kind == RNG_MRG32K3A) {
+    PlantMRG(g, g->stream[0].seed, 0);
+    return;
+  }
+  g->stream[0].kind = RNG_LEHMER;
   for (j = 1; j < STREAMS; j++) {
-    x = A256 * (seed[j - 1] % Q) - R * (seed[j - 1] / Q);
+    g->stream[j].kind = RNG_LEHMER;
+    x = A256 * (g->stream[j - 1].seed % Q) - R * (g->stream[j - 1].seed / Q);
     if (x > 0)
-      seed[j] = x;
+      g->stream[j].seed = x;
     else
-      seed[j] = x + MODULUS;
+      g->stream[j].seed = x + MODULUS;
    }
 }
 
 
-   void PutSeed(long x)
+   void PutSeedR(rngs_state *g, long x)
 /* ---------------------------------------------------------------
  * Use this function to set the state of the current random number 
  * generator stream according to the following conventions:
@@ -122,31 +356,203 @@ static int  initialized   = 0;          /* test for stream initialization */
       if (!ok)
         printf("\nInput out of range ... try again\n");
     }
-  seed[stream] = x;
+  g->stream[g->current].seed = x;
 }
 
 
-   void GetSeed(long *x)
+   void GetSeedR(rngs_state *g, long *x)
 /* ---------------------------------------------------------------
  * Use this function to get the state of the current random number 
  * generator stream.                                                   
  * ---------------------------------------------------------------
  */
 {
-  *x = seed[stream];
+  *x = g->stream[g->current].seed;
 }
 
 
-   void SelectStream(int index)
+   void SelectStreamR(rngs_state *g, int index)
 /* ------------------------------------------------------------------
  * Use this function to set the current random number generator
  * stream -- that stream from which the next random number will come.
  * ------------------------------------------------------------------
  */
 {
-  stream = ((unsigned int) index) % STREAMS;
-  if ((initialized == 0) && (stream != 0))   /* protect against        */
-    PlantSeeds(DEFAULT);                     /* un-initialized streams */
+  g->current = ((unsigned int) index) % STREAMS;
+  if ((g->initialized == 0) && (g->current != 0)) /* protect against        */
+    PlantSeedsR(g, DEFAULT);                      /* un-initialized streams */
+}
+
+
+   rng_stream *StreamR(rngs_state *g, int index)
+/* ------------------------------------------------------------------
+ * Use this function to get a handle of stream index, to draw from it
+ * with RandomR() and the generators of rvgs.c without selecting it:
+ * the handle stays valid as long as the set of streams g.
+ * ------------------------------------------------------------------
+ */
+{
+  index = ((unsigned int) index) % STREAMS;
+  if ((g->initialized == 0) && (index != 0))      /* protect against        */
+    PlantSeedsR(g, DEFAULT);                      /* un-initialized streams */
+  return (&g->stream[index]);
+}
+
+
+   rng_stream *CurrentStreamR(rngs_state *g)
+/* ------------------------------------------------------------------
+ * The handle of the stream selected by SelectStreamR().
+ * ------------------------------------------------------------------
+ */
+{
+  return (&g->stream[g->current]);
+}
+
+
+   void InitStreamsR(rngs_state *g)
+/* ------------------------------------------------------------------
+ * Use this function to give a new set of streams the same initial
+ * state of the library: default seed, stream 0 and not yet planted.
+ * Every independent simulation should own its set of streams, so
+ * that simulations running at the same time do not share state.
+ * ------------------------------------------------------------------
+ */
+{
+  int j;
+
+  g->stream[0].seed = DEFAULT;
+  for (j = 1; j < STREAMS; j++)
+    g->stream[j].seed = 0;
+  for (j = 0; j < STREAMS; j++)
+    g->stream[j].kind = RNG_LEHMER;
+  g->current     = 0;
+  g->initialized = 0;
+  g->kind        = RNG_LEHMER;
+}
+
+
+   void SetGeneratorR(rngs_state *g, int kind)
+/* ------------------------------------------------------------------
+ * Use this function to choose the generator, RNG_LEHMER (the default)
+ * or RNG_MRG32K3A, of the streams planted next by PlantSeedsR() or
+ * PlantReplicationR().
+ * ------------------------------------------------------------------
+ */
+{
+  g->kind        = (kind == RNG_MRG32K3A) ? RNG_MRG32K3A : RNG_LEHMER;
+  g->initialized = 0;
+}
+
+
+   const char *GeneratorName(int kind)
+{
+  return ((kind == RNG_MRG32K3A) ? "mrg32k3a" : "lehmer");
+}
+
+
+   long JumpSeed(long x, long n)
+/* ------------------------------------------------------------------
+ * Use this function to get the state of a stream n calls to Random()
+ * after the state x, in O(log n) steps: x * MULTIPLIER^n mod MODULUS.
+ * ------------------------------------------------------------------
+ */
+{
+  unsigned long long a = MULTIPLIER;
+  unsigned long long y = ((unsigned long long) x) % MODULUS;
+
+  n %= (MODULUS - 1);                    /* the period of the generator */
+  while (n > 0) {
+    if (n & 1)
+      y = (y * a) % MODULUS;
+    a = (a * a) % MODULUS;
+    n >>= 1;
+  }
+  return ((long) y);
+}
+
+
+   void PlantReplicationR(rngs_state *g, long x, long r, long replications,
+                          int streams)
+/* ------------------------------------------------------------------
+ * Use this function to give replication r (0 <= r < replications) a
+ * fixed set of streams that does not overlap the streams of the other
+ * replications. The period of the generator is cut in
+ * replications * streams blocks of equal length, starting from the
+ * state x, and stream j of replication r starts at the block
+ * r * streams + j. Only streams 0, 1, ..., streams - 1 are disjoint
+ * from the other replications: a replication should use only those.
+ * With MRG32k3a all the streams of replication r are substream r of
+ * the streams planted from x, whatever replications and streams.
+ * ------------------------------------------------------------------
+ */
+{
+  long blocks = replications * streams;
+  long length = (MODULUS - 1) / blocks;  /* calls to Random() per block */
+  int  j;
+
+  if (x <= 0 || x % MODULUS == 0)
+    x = DEFAULT;
+  g->current     = 0;
+  g->initialized = 1;
+  if (g->kind == RNG_MRG32K3A) {
+    PlantMRG(g, x % MODULUS, r);
+    return;
+  }
+  for (j = 0; j < STREAMS; j++) {
+    g->stream[j].seed = JumpSeed(x, ((r * streams + j) % blocks) * length);
+    g->stream[j].kind = RNG_LEHMER;
+  }
+}
+
+
+   rngs_state *GlobalStreams(void)
+/* ------------------------------------------------------------------
+ * The original interface below works on this global set of streams.
+ * ------------------------------------------------------------------
+ */
+{
+  return (&global);
+}
+
+
+   double Random(void)
+{
+  return (RandomR(&global.stream[global.current]));
+}
+
+   void PlantSeeds(long x)
+{
+  PlantSeedsR(&global, x);
+}
+
+   void PutSeed(long x)
+{
+  PutSeedR(&global, x);
+}
+
+   void GetSeed(long *x)
+{
+  GetSeedR(&global, x);
+}
+
+   void SelectStream(int index)
+{
+  SelectStreamR(&global, index);
+}
+
+   void RandomFill(int stream, double *out, long n)
+{
+  RandomFillR(Stream(stream), out, n);
+}
+
+   rng_stream *Stream(int index)
+{
+  return (StreamR(&global, index));
+}
+
+   void SetGenerator(int kind)
+{
+  SetGeneratorR(&global, kind);
 }
 
 
@@ -165,6 +571,7 @@ static int  initialized   = 0;          /* test for stream initialization */
   PutSeed(1);                       /* and set the state to 1    */
   for(i = 0; i < 10000; i++)
     u = Random();
+  (void) u;                         /* only the state is checked */
   GetSeed(&x);                      /* get the new state value   */
   ok = (x == CHECK);                /* and check for correctness */
 
@@ -177,3 +584,130 @@ static int  initialized   = 0;          /* test for stream initialization */
   else
     printf("\n\a ERROR -- the implementation of rngs.c is not correct.\n\n");
 }
+
+
+typedef struct {                    /* start of a substream, for TestStreams */
+  unsigned long long key;
+  long               index;
+} substream;
+
+   static int CompareSubstreams(const void *a, const void *b)
+{
+  unsigned long long x = ((const substream *) a)->key;
+  unsigned long long y = ((const substream *) b)->key;
+
+  return ((x > y) - (x < y));
+}
+
+   static int SameStart(long a, long b, int streams)
+/* ------------------------------------------------------------------
+ * do the streams a and b of TestStreams start from the same state?
+ * ------------------------------------------------------------------
+ */
+{
+  static rngs_state g, h;
+  int               k;
+
+  InitStreamsR(&g);
+  InitStreamsR(&h);
+  SetGeneratorR(&g, RNG_MRG32K3A);
+  SetGeneratorR(&h, RNG_MRG32K3A);
+  PlantReplicationR(&g, DEFAULT, a / streams, 1, streams);
+  PlantReplicationR(&h, DEFAULT, b / streams, 1, streams);
+  for (k = 0; k < 6; k++)
+    if (g.stream[a % streams].s[k] != h.stream[b % streams].s[k])
+      return (0);
+  return (1);
+}
+
+   void TestStreams(long replications)
+/* ------------------------------------------------------------------
+ * Use this (optional) function to test the MRG32k3a streams: the
+ * first random number and the second stream of the seed 12345 must be
+ * the ones of the RngStreams package, jumps must agree with draws, and
+ * the streams 0, 1 and 2 of the given number of replications must all
+ * start from different states. Since every start is 2^76 draws after
+ * the previous one in the same stream, and 2^76 is far more than any
+ * simulation can draw, they do not overlap.
+ * ------------------------------------------------------------------
+ */
+{
+  static const long long stream1[6] = {3692455944LL, 1366884236LL,
+                                       2968912127LL, 335948734LL,
+                                       4161675175LL, 475798818LL};
+  static rngs_state g, h;
+  const int   streams = 3;               /* arrivals, APs and switch    */
+  long long   v[3][6];
+  mrg_matrix  c1, c2;
+  substream  *start;
+  rng_stream  a, b;
+  long        r, n, same = 0;
+  int         j, k;
+  double      u;
+  char        ok;
+
+  InitStreamsR(&g);
+  SetGeneratorR(&g, RNG_MRG32K3A);
+  PlantSeedsR(&g, 12345);
+  u  = RandomR(&g.stream[0]);
+  ok = (0.1270111219 < u) && (u < 0.1270111221);
+  for (k = 0; k < 6; k++)
+    ok = ok && (g.stream[1].s[k] == stream1[k]);
+
+  a = b = g.stream[2];                   /* jumps against draws         */
+  for (n = 0; n < 100000; n++)
+    RandomR(&a);
+  JumpStream(&b, 100000);
+  for (k = 0; k < 6; k++)
+    ok = ok && (a.s[k] == b.s[k]);
+  InitStreamsR(&h);
+  PlantSeedsR(&h, 12345);
+  a = b = h.stream[2];
+  for (n = 0; n < 100000; n++)
+    RandomR(&a);
+  JumpStream(&b, 100000);
+  ok = ok && (a.seed == b.seed);
+
+  start = malloc(replications * streams * sizeof(substream));
+  if (start == NULL) {
+    printf("\n\a ERROR -- out of memory.\n\n");
+    return;
+  }
+  SetGeneratorR(&h, RNG_MRG32K3A);
+  PlantReplicationR(&g, DEFAULT, 0, replications, streams);
+  MatPow(A1, 1, SUB_LOG, c1, M1);
+  MatPow(A2, 1, SUB_LOG, c2, M2);
+  for (j = 0; j < streams; j++)
+    for (k = 0; k < 6; k++)
+      v[j][k] = g.stream[j].s[k];
+  for (r = 0; r < replications; r++) {
+    if (r % 65536 == 1) {                /* the sequence against jumps  */
+      PlantReplicationR(&h, DEFAULT, r, replications, streams);
+      for (j = 0; j < streams; j++)
+        for (k = 0; k < 6; k++)
+          ok = ok && (h.stream[j].s[k] == v[j][k]);
+    }
+    for (j = 0; j < streams; j++) {
+      start[r * streams + j].key   = ((unsigned long long) v[j][0] << 32) ^
+                                     (unsigned long long) v[j][3];
+      start[r * streams + j].index = r * streams + j;
+      MatVec(c1, v[j], M1);
+      MatVec(c2, v[j] + 3, M2);
+    }
+  }
+  qsort(start, replications * streams, sizeof(substream), CompareSubstreams);
+  for (n = 1; n < replications * streams; n++)
+    if (start[n].key == start[n - 1].key &&
+        SameStart(start[n].index, start[n - 1].index, streams))
+      same++;
+  free(start);
+
+  printf("\n MRG32k3a: %ld replications x %d streams, %ld equal starts\n",
+         replications, streams, same);
+  printf(" Lehmer:   %ld replications x %d streams, %ld draws per stream\n",
+         replications, streams, (MODULUS - 1) / (replications * streams));
+  if (ok && same == 0)
+    printf("\n The MRG32k3a streams of rngs.c are correct.\n\n");
+  else
+    printf("\n\a ERROR -- the MRG32k3a streams of rngs.c are not correct.\n\n");
+}
@@ -9,11 +9,72 @@
 #if !defined( _RNGS_ )
 #define _RNGS_
 
+#define STREAMS 256   /* # of streams, DON'T CHANGE THIS VALUE */
+
+#define RNG_LEHMER   0  /* Park & Miller, period 2^31 - 2           */
+#define RNG_MRG32K3A 1  /* L'Ecuyer, period 2^191, with substreams  */
+
+typedef struct {                      /* state of one stream               */
+  long      seed;                     /* RNG_LEHMER                        */
+  long long s[6];                     /* RNG_MRG32K3A, two components      */
+  int       kind;
+} rng_stream;
+
+typedef struct {                      /* state of a whole set of streams,  */
+  rng_stream stream[STREAMS];         /* one per independent simulation    */
+  int        current;                 /* the selected stream               */
+  int        initialized;
+  int        kind;                    /* generator planted by PlantSeeds   */
+} rngs_state;
+
+double RandomMRG(rng_stream *s);
+
+static inline double RandomR(rng_stream *s)
+/* ----------------------------------------------------------------
+ * RandomR returns a pseudo-random real number uniformly distributed
+ * between 0.0 and 1.0 from stream s (Schrage's method for the Lehmer
+ * generator, see rngs.c).
+ * ----------------------------------------------------------------
+ */
+{
+  const long m = 2147483647, a = 48271;  /* MODULUS and MULTIPLIER  */
+  const long Q = m / a;
+  const long R = m % a;
+        long t;
+
+  if (s->kind == RNG_MRG32K3A)
+    return (RandomMRG(s));
+  t = a * (s->seed % Q) - R * (s->seed / Q);
+  s->seed = (t > 0) ? t : t + m;
+  return ((double) s->seed / m);
+}
+
 double Random(void);
 void   PlantSeeds(long x);
 void   GetSeed(long *x);
 void   PutSeed(long x);
 void   SelectStream(int index);
 void   TestRandom(void);
+void   RandomFill(int stream, double *out, long n);
+rng_stream *Stream(int index);
+void   SetGenerator(int kind);
+void   TestStreams(long replications);
+
+void   PlantSeedsR(rngs_state *g, long x);
+void   GetSeedR(rngs_state *g, long *x);
+void   PutSeedR(rngs_state *g, long x);
+void   SelectStreamR(rngs_state *g, int index);
+void   InitStreamsR(rngs_state *g);
+rng_stream *StreamR(rngs_state *g, int index);
+rng_stream *CurrentStreamR(rngs_state *g);
+void   SetGeneratorR(rngs_state *g, int kind);
+const char *GeneratorName(int kind);
+void   RandomFillR(rng_stream *s, double *out, long n);
+rngs_state *GlobalStreams(void);
+
+long   JumpSeed(long x, long n);
+void   JumpStream(rng_stream *s, long long n);
+void   PlantReplicationR(rngs_state *g, long x, long r, long replications,
+                         int streams);
 
 #endif
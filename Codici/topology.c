@@ -0,0 +1,424 @@
+/* -------------------------------------------------------------------------- *
+ * This is a library that describes the network to simulate: its nodes, by   *
+ * groups of equal nodes, the service time of each group and the routing,    *
+ * read from a topology file instead of being fixed in the programs.          *
+ * A topology file has one statement per line:                                *
+ *                                                                            *
+ *      group NAME COUNT DIST PARAMETERS [capacity N]                         *
+ *      route FROM TO WEIGHT [all | block]                                    *
+ *      capacity NODES N                                                      *
+ *                                                                            *
+ * and # starts a comment. A group declares COUNT nodes, numbered after the   *
+ * nodes of the groups before it, whose service time is DIST:                 *
+ *                                                                            *
+ *      exp MEAN | erlang N B | normal M S | lognormal A B | bp ALPHA MIN MAX *
+ *                                                                            *
+ * FROM and TO are a group (all its nodes), NAME[k] (its k-th node, from 1),  *
+ * source (the arrivals from outside, only as FROM) or exit (only as TO).     *
+ * With all, every node of FROM sends its jobs to every node of TO with that  *
+ * weight; with block the nodes of FROM are split in as many consecutive      *
+ * blocks as the nodes of TO, and each block goes to one node only (such as   *
+ * the APs of a floor to the switch of the floor). The probabilities of each  *
+ * row are the weights over their sum, in the order of the statements (see    *
+ * routing.c), and a node without routes sends its jobs out of the network.   *
+ * The model of nsssn_bp.c is then                                            *
+ *                                                                            *
+ *      group AP 4 bp 0.5 0.3756009615 8.756197416                            *
+ *      group Sw 1 bp 0.5 0.002709302035 0.0631606037                         *
+ *      route source AP 1                                                     *
+ *      route source Sw 16                                                    *
+ *      route AP Sw 1                                                         *
+ *      route Sw exit 1                                                       *
+ *                                                                            *
+ * The nodes are loaded in flat tables, one entry per node (structure of     *
+ * arrays, as the tables of netsim.c), so that the simulation reaches the     *
+ * group and the capacity of a node with one index, whatever its size.        *
+ *                                                                            *
+ * Name            : topology.c  (Network Topology)                           *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rvgs.h"
+#include "routing.h"
+#include "topology.h"
+
+#define BLANKS " \t\r\n"
+
+// A route statement, kept until the number of nodes is known
+typedef struct
+{
+    int from, nfrom; // first node and nodes of FROM (0: source)
+    int to, nto;     // first node and nodes of TO (0: exit)
+    double weight;
+    int block;       // 1 for block, 0 for all
+} route_line;
+
+static int AddGroup(topology *t, const char *name, int count,
+                    const rv_dist *d, long capacity)
+{
+    /* -------------------------------------------------------------------------- *
+     * append a group of count nodes, return -1 if out of memory                  *
+     * -------------------------------------------------------------------------- */
+    int g = t->groups;
+    int nodes = t->nodes + count;
+    void *p;
+
+    if ((p = realloc(t->name, (g + 1) * sizeof(*t->name))) == NULL)
+        return -1;
+    t->name = p;
+    if ((p = realloc(t->first, (g + 1) * sizeof(int))) == NULL)
+        return -1;
+    t->first = p;
+    if ((p = realloc(t->count, (g + 1) * sizeof(int))) == NULL)
+        return -1;
+    t->count = p;
+    if ((p = realloc(t->service, (g + 1) * sizeof(rv_dist))) == NULL)
+        return -1;
+    t->service = p;
+    if ((p = realloc(t->group, (nodes + 1) * sizeof(int))) == NULL)
+        return -1;
+    t->group = p;
+    if ((p = realloc(t->capacity, (nodes + 1) * sizeof(long))) == NULL)
+        return -1;
+    t->capacity = p;
+
+    snprintf(t->name[g], GROUP_NAME, "%s", name);
+    t->first[g] = t->nodes + 1;
+    t->count[g] = count;
+    t->service[g] = *d;
+    for (int i = t->nodes + 1; i <= nodes; i++)
+    {
+        t->group[i] = g;
+        t->capacity[i] = capacity;
+    }
+    t->groups = g + 1;
+    t->nodes = nodes;
+    return 0;
+}
+
+static int AddRoutes(routing *r, const route_line *l)
+{
+    /* -------------------------------------------------------------------------- *
+     * the entries of the routing matrix of a route statement                     *
+     * -------------------------------------------------------------------------- */
+    int error = 0;
+
+    for (int i = 0; i < l->nfrom && !error; i++)
+    {
+        if (l->block)
+            error = AddRoute(r, l->from + i,
+                             l->to + (int)((long long)i * l->nto / l->nfrom),
+                             l->weight);
+        else
+            for (int j = 0; j < l->nto && !error; j++)
+                error = AddRoute(r, l->from + i, l->to + j, l->weight);
+    }
+    return error;
+}
+
+int FindGroup(const topology *t, const char *name)
+{
+    /* -------------------------------------------------------------------------- *
+     * the index of the group called name, -1 if there is none                    *
+     * -------------------------------------------------------------------------- */
+    for (int g = 0; g < t->groups; g++)
+    {
+        if (strcmp(t->name[g], name) == 0)
+            return g;
+    }
+    return -1;
+}
+
+static const char *Nodes(const topology *t, char *word, int *first, int *n)
+{
+    /* -------------------------------------------------------------------------- *
+     * the nodes of a group, or of NAME[k], or source and exit (node 0); return   *
+     * NULL on success, else the error                                            *
+     * -------------------------------------------------------------------------- */
+    char *bracket = strchr(word, '[');
+    int g;
+
+    if (strcmp(word, "source") == 0 || strcmp(word, "exit") == 0)
+    {
+        *first = 0;
+        *n = 1;
+        return NULL;
+    }
+    if (bracket != NULL)
+        *bracket = '\0';
+    if ((g = FindGroup(t, word)) < 0)
+        return "unknown group (groups must be declared before their routes)";
+    *first = t->first[g];
+    *n = t->count[g];
+    if (bracket != NULL)
+    {
+        char *end;
+        long k = strtol(bracket + 1, &end, 10);
+
+        if (*end != ']' || end[1] != '\0' || k < 1 || k > t->count[g])
+            return "bad node index";
+        *first += k - 1;
+        *n = 1;
+    }
+    return NULL;
+}
+
+static const char *GroupStatement(topology *t, char **save)
+{
+    /* -------------------------------------------------------------------------- *
+     * a group statement: NAME COUNT DIST PARAMETERS [capacity N]                 *
+     * -------------------------------------------------------------------------- */
+    char *name = strtok_r(NULL, BLANKS, save);
+    char *word = strtok_r(NULL, BLANKS, save);
+    char *dist = strtok_r(NULL, BLANKS, save);
+    double x[3];
+    int n = 0;
+    long count, capacity = 0;
+    rv_dist d;
+    int error;
+
+    if (name == NULL || word == NULL || dist == NULL)
+        return "expected group NAME COUNT DIST PARAMETERS";
+    if (strlen(name) >= GROUP_NAME || strchr(name, '[') != NULL ||
+        strcmp(name, "source") == 0 || strcmp(name, "exit") == 0)
+        return "bad group name";
+    if (FindGroup(t, name) >= 0)
+        return "group already declared";
+    count = strtol(word, &word, 10);
+    if (*word != '\0' || count < 1 || count > 100000000)
+        return "bad number of nodes";
+
+    while ((word = strtok_r(NULL, BLANKS, save)) != NULL)
+    {
+        char *end;
+
+        if (strcmp(word, "capacity") == 0)
+        {
+            if ((word = strtok_r(NULL, BLANKS, save)) == NULL)
+                return "expected capacity N";
+            capacity = strtol(word, &end, 10);
+            if (*end != '\0' || capacity < 0)
+                return "bad capacity";
+            if (strtok_r(NULL, BLANKS, save) != NULL)
+                return "unexpected words after the capacity";
+            break;
+        }
+        if (n == 3)
+            return "too many parameters";
+        x[n++] = strtod(word, &end);
+        if (*end != '\0')
+            return "bad parameter";
+    }
+
+    if (strcmp(dist, "exp") == 0 && n == 1)
+        error = ExponentialDist(&d, x[0]);
+    else if (strcmp(dist, "erlang") == 0 && n == 2)
+        error = (x[0] != (long)x[0]) || ErlangDist(&d, (long)x[0], x[1]);
+    else if (strcmp(dist, "normal") == 0 && n == 2)
+        error = NormalDist(&d, x[0], x[1]);
+    else if (strcmp(dist, "lognormal") == 0 && n == 2)
+        error = LognormalDist(&d, x[0], x[1]);
+    else if (strcmp(dist, "bp") == 0 && n == 3)
+        error = BoundedParetoDist(&d, x[0], x[1], x[2]);
+    else
+        return "unknown distribution or wrong number of parameters";
+    if (error)
+        return "bad parameters of the distribution";
+    if (t->nodes + count > 100000000)
+        return "too many nodes";
+    if (AddGroup(t, name, (int)count, &d, capacity) != 0)
+        return "out of memory";
+    return NULL;
+}
+
+static const char *RouteStatement(topology *t, char **save, route_line *l)
+{
+    /* -------------------------------------------------------------------------- *
+     * a route statement: FROM TO WEIGHT [all | block]                            *
+     * -------------------------------------------------------------------------- */
+    char *from = strtok_r(NULL, BLANKS, save);
+    char *to = strtok_r(NULL, BLANKS, save);
+    char *word = strtok_r(NULL, BLANKS, save);
+    char *mode = strtok_r(NULL, BLANKS, save);
+    const char *error;
+
+    if (from == NULL || to == NULL || word == NULL)
+        return "expected route FROM TO WEIGHT";
+    if (strcmp(from, "exit") == 0 || strcmp(to, "source") == 0)
+        return "no route can leave the exit or enter the source";
+    if ((error = Nodes(t, from, &l->from, &l->nfrom)) != NULL ||
+        (error = Nodes(t, to, &l->to, &l->nto)) != NULL)
+        return error;
+    l->weight = strtod(word, &word);
+    if (*word != '\0' || !(l->weight > 0.0))
+        return "the weight must be positive";
+    l->block = 0;
+    if (mode != NULL)
+    {
+        if (strcmp(mode, "block") == 0)
+            l->block = 1;
+        else if (strcmp(mode, "all") != 0)
+            return "expected all or block";
+        if (strtok_r(NULL, BLANKS, save) != NULL)
+            return "unexpected words after the route";
+    }
+    return NULL;
+}
+
+static const char *CapacityStatement(topology *t, char **save)
+{
+    /* -------------------------------------------------------------------------- *
+     * a capacity statement: NODES N                                              *
+     * -------------------------------------------------------------------------- */
+    char *nodes = strtok_r(NULL, BLANKS, save);
+    char *word = strtok_r(NULL, BLANKS, save);
+    const char *error;
+    int first, n;
+    long capacity;
+
+    if (nodes == NULL || word == NULL || strtok_r(NULL, BLANKS, save) != NULL)
+        return "expected capacity NODES N";
+    if ((error = Nodes(t, nodes, &first, &n)) != NULL)
+        return error;
+    if (first == 0)
+        return "the source and the exit have no queue";
+    capacity = strtol(word, &word, 10);
+    if (*word != '\0' || capacity < 0)
+        return "bad capacity";
+    for (int i = first; i < first + n; i++)
+        t->capacity[i] = capacity;
+    return NULL;
+}
+
+topology *LoadTopology(const char *path)
+{
+    /* -------------------------------------------------------------------------- *
+     * read a topology file, return NULL (with a message) if it is not valid      *
+     * -------------------------------------------------------------------------- */
+    char line[1024];
+    int number = 0;
+    const char *error = NULL;
+    route_line *routes = NULL;
+    long n = 0, size = 0;
+    topology *t;
+    FILE *f = fopen(path, "r");
+
+    if (f == NULL)
+    {
+        fprintf(stderr, "Error: cannot open '%s'\n", path);
+        return NULL;
+    }
+    if ((t = calloc(1, sizeof(topology))) == NULL)
+    {
+        fclose(f);
+        return NULL;
+    }
+    while (error == NULL && fgets(line, sizeof(line), f) != NULL)
+    {
+        char *save;
+        char *word;
+
+        number++;
+        line[strcspn(line, "#")] = '\0';
+        if ((word = strtok_r(line, BLANKS, &save)) == NULL)
+            continue;
+        if (strcmp(word, "group") == 0)
+            error = GroupStatement(t, &save);
+        else if (strcmp(word, "capacity") == 0)
+            error = CapacityStatement(t, &save);
+        else if (strcmp(word, "route") == 0)
+        {
+            if (n == size)
+            {
+                route_line *r;
+
+                size = (size > 0) ? 2 * size : 64;
+                if ((r = realloc(routes, size * sizeof(route_line))) == NULL)
+                {
+                    error = "out of memory";
+                    break;
+                }
+                routes = r;
+            }
+            if ((error = RouteStatement(t, &save, &routes[n])) == NULL)
+                n++;
+        }
+        else
+            error = "expected group, route or capacity";
+    }
+    fclose(f);
+
+    if (error == NULL)
+    {
+        number = 0;
+        if (t->nodes == 0)
+            error = "no groups";
+        else if ((t->route = CreateRouting(t->nodes)) == NULL)
+            error = "out of memory";
+        for (long i = 0; i < n && error == NULL; i++)
+        {
+            if (AddRoutes(t->route, &routes[i]) != 0)
+                error = "out of memory";
+        }
+        if (error == NULL && BuildRouting(t->route) != 0)
+            error = "out of memory";
+        if (error == NULL && Destinations(t->route, 0) == 0)
+            error = "no route from the source";
+    }
+    free(routes);
+    if (error != NULL)
+    {
+        if (number > 0)
+            fprintf(stderr, "Error: %s:%d: %s\n", path, number, error);
+        else
+            fprintf(stderr, "Error: %s: %s\n", path, error);
+        FreeTopology(t);
+        return NULL;
+    }
+    return (t);
+}
+
+topology *CampusTopology(int servers, double alpha, double ap_min,
+                         double ap_max, double sw_min, double sw_max,
+                         long capacity)
+{
+    /* -------------------------------------------------------------------------- *
+     * the model of nsssn_bp.c: servers - 1 APs (group 0) with queues of          *
+     * capacity jobs, and the switch (group 1), with the routing of               *
+     * CampusRouting() in routing.c                                               *
+     * -------------------------------------------------------------------------- */
+    topology *t = calloc(1, sizeof(topology));
+    rv_dist ap, sw;
+
+    if (t == NULL)
+        return NULL;
+    if (BoundedParetoDist(&ap, alpha, ap_min, ap_max) != 0 ||
+        BoundedParetoDist(&sw, alpha, sw_min, sw_max) != 0 ||
+        AddGroup(t, "AP", servers - 1, &ap, capacity) != 0 ||
+        AddGroup(t, "Sw", 1, &sw, 0) != 0 ||
+        (t->route = CampusRouting(servers)) == NULL)
+    {
+        FreeTopology(t);
+        return NULL;
+    }
+    return (t);
+}
+
+void FreeTopology(topology *t)
+{
+    if (t == NULL)
+        return;
+    free(t->name);
+    free(t->first);
+    free(t->count);
+    free(t->service);
+    free(t->group);
+    free(t->capacity);
+    FreeRouting(t->route);
+    free(t);
+}
@@ -0,0 +1,37 @@
+/* -------------------------------------------------------------------------- *
+ * Name            : topology.h  (header file for the library topology.c)     *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#if !defined(_TOPOLOGY_)
+#define _TOPOLOGY_
+
+#include "rvgs.h"
+#include "routing.h"
+
+#define GROUP_NAME 16 /* characters of a group name, with the '\0' */
+
+// Nodes of a network, by groups of equal nodes
+typedef struct
+{
+    int nodes;                     // nodes 1, 2, ..., nodes
+    int groups;                    // groups 0, 1, ..., groups - 1
+    char (*name)[GROUP_NAME];      // name of each group
+    int *first;                    // first node of each group
+    int *count;                    // nodes of each group
+    rv_dist *service;              // service time of each group
+    int *group;                    // group of each node, [1, nodes]
+    long *capacity;                // queue capacity of each node, 0 if infinite
+    routing *route;                // routing matrix
+} topology;
+
+topology *LoadTopology(const char *path);
+topology *CampusTopology(int servers, double alpha, double ap_min,
+                         double ap_max, double sw_min, double sw_max,
+                         long capacity);
+void FreeTopology(topology *t);
+int FindGroup(const topology *t, const char *name);
+
+#endif
@@ -1,290 +1,70 @@
 /* -------------------------------------------------------------------------- * 
  * This program makes a transient analysis of the system with loss.           *
- * Number of replication can be setted at row 290, in the for cycle.          *
- * Time of the simulation can be modified at 280.                             *  
- * times distributions and ratios are tested, meanwhile service time          *
+ * Number of replication can be setted with REPLICATIONS.                     *
+ * Time of the simulation can be modified in main, t_arresto.                 *
  * Results of the analysis will be printed on a file.                         *
+ * The replications are the ones of ReplicateSimulation() (analysis.c) on    *
+ * the simulation of netsim.c.                                                *
  *                                                                            *
  * Name            : transiente_loss.c  (Transient An. of nsssn_bp_loss.c)    *
  * Authors         : G. La Delfa, D. Verde, G. A. Tummolo                     *
  * Language        : C                                                        *
- * Latest Revision : 08-09-2021                                               *
+ * Latest Revision : 15-10-2026                                               *
  * -------------------------------------------------------------------------- */
 
 #include <stdio.h>
-#include <math.h>
-#include "rngs.h" // the multi-stream generator
-#include "rvgs.h" // random variate generators
+#include "rngs.h"     // the multi-stream generator
+#include "evlist.h"   // event list management
+#include "netsim.h"   // simulation of the network
+#include "analysis.h" // output analysis
 
-#define START 0.0
-#define INFINITE (30000000.0)
+#define EVENT_LIST EVENT_HEAP
+#define GENERATOR RNG_LEHMER
 #define SERVERS 5
 #define LAMBDA 10
 #define ALPHA 0.5   //shape parameter of BP Distribution
 #define CAPACITY 10 //AP queue capacity
+#define REPLICATIONS 100
 
-typedef struct
+static void Replication(const sim_context *s, long r, void *arg)
 {
-    double t;
-    int x;
-} event_list[SERVERS + 1];
+    FILE *file = arg;
 
-typedef struct
-{
-    double current;
-    double next;
-} t;
-
-typedef struct
-{
-    double service;
-    long served;
-    long arrives;
-
-} sum[SERVERS + 1];
-
-long number[SERVERS] = {0, 0, 0, 0, 0};
-long arrivals = 0;
-long departures = 0;
-long refused = 0;
-double area[SERVERS] = {0.0, 0.0, 0.0, 0.0, 0.0};
-double STOP = 0;
-double arrival = START;
-
-sum statistics;
-event_list event;
-t clock;
-
-double GetArrival(double arrival)
-{
-    SelectStream(0);
-    arrival += Exponential(1.0 / LAMBDA);
-    return (arrival);
-}
-
-double GetService_AP()
-{
-    SelectStream(1);
-    return BoundedPareto(ALPHA, 0.3756009615, 8.756197416);
-}
-
-double GetService_Switch()
-{
-    SelectStream(2);
-    return BoundedPareto(ALPHA, 0.002709302035, 0.0631606037);
-}
-
-void ProcessArrival(int index)
-{
-    double service_time = 0.0;
-    if (number[index - 1] == 0)
-    {
-        if (index == 5)
-        {
-            service_time = GetService_Switch();
-        }
-        else
-        {
-            service_time = GetService_AP();
-        }
-        event[index].t = service_time + clock.current;
-        event[index].x = 1;
-        statistics[index].service += service_time;
-        statistics[index].served++;
-    }
-
-    number[index - 1]++;
-}
-
-void ProcessDeparture(int index)
-{
-    double service_time = 0.0;
-    if (index < 5)
-    {
-        ProcessArrival(5);
-    }
-    else
-    {
-        departures++;
-    }
-
-    number[index - 1]--;
-
-    if (number[index - 1] > 0)
-    {
-        if (index == 5)
-        {
-            service_time = GetService_Switch();
-        }
-        else
-        {
-            service_time = GetService_AP();
-        }
-        event[index].t = service_time + clock.current;
-        event[index].x = 1;
-        statistics[index].service += service_time;
-        statistics[index].served++;
-    }
-    else
-    {
-        event[index].t = INFINITE;
-        event[index].x = 0;
-    }
-}
-
-int NextEvent(event_list event)
-{
-    int e;
-    int i = 0;
-
-    while (event[i].x == 0)
-        i++;
-
-    e = i;
-    while (i < SERVERS + 1)
-    {
-        i++;
-        if ((event[i].x == 1) && (event[i].t < event[e].t))
-            e = i;
-    }
-    return (e);
-}
-
-void initialize()
-{
-    /* ------------------------------------------------------------------------ *
-     * Function to initialize all system statistics                             *                                     *
-     * ------------------------------------------------------------------------ */
-    for (int i = 0; i < SERVERS; i++)
-    {
-        number[i] = 0;
-        area[i] = 0.0;
-    }
-    for (int s = 1; s <= SERVERS; s++)
-    {
-        event[s].t = INFINITE;
-        event[s].x = 0;
-        statistics[s].service = 0.0;
-        statistics[s].served = 0;
-    }
-    arrivals = 0;
-    departures = 0;
-    event[0].t = 0;
-    refused = 0;
-}
-
-// double transient(double t_arresto, long seed)
-double transient(double t_arresto)
-{
-    initialize();
-
-    // GetSeed(&seed); //ogni volta che eseguo getSeed, ottengo lo stato del generatore
-    // printf("seed iniziale: %ld\n", seed);
-
-    STOP = t_arresto;
-    clock.current = START;               // set the clock
-    event[0].t = GetArrival(event[0].t); // schedule the first arrival
-    event[0].x = 1;
-    int e = 0;
-
-    while (event[0].t < STOP)
-    {
-        e = NextEvent(event);
-        clock.next = event[e].t;
-        for (int j = 0; j < SERVERS; j++)
-        {
-            area[j] += (clock.next - clock.current) * number[j];
-        }
-
-        clock.current = clock.next;
-        if (e == 0)
-        {
-            arrivals++; // Process an Arrival
-
-            double rnd = Random(); // Detect where it comes
-            int s;
-            if (rnd > 0 && rnd <= 1.0 / 20)
-            {
-                s = 1;
-            }
-            else if (rnd > 1.0 / 20 && rnd <= 2.0 / 20)
-            {
-                s = 2;
-            }
-            else if (rnd > 2.0 / 20 && rnd <= 3.0 / 20)
-            {
-                s = 3;
-            }
-            else if (rnd > 3.0 / 20 && rnd <= 4.0 / 20)
-            {
-                s = 4;
-            }
-            else
-            {
-                s = 5;
-            }
-
-            if (number[s - 1] > CAPACITY && s < 5)
-            {
-                /* -------------------------------------------------------------------------- * 
-                 * if the queue is full the job is rejected and a new arrival is scheduled    *
-                 * -------------------------------------------------------------------------- */
-                refused++;
-            }
-            else
-            {
-                statistics[s].arrives++; //increase number of arrivals for that node
-                ProcessArrival(s);
-            }
-
-            event[0].t = GetArrival(event[0].t); // Scheduling Next Arrival
-            if (event[0].t > STOP)
-            {
-                event[0].x = 0;
-            }
-        }
-        else
-        {
-            ProcessDeparture(e); // Process a Departure (e indicates server number)
-        }
-    }
-
-    printf("%ld - %4.2f %%\n", refused, 100.0 * refused / arrivals);
-
-    double avg_wait = (area[0] / statistics[1].served +
-                       area[1] / statistics[2].served +
-                       area[2] / statistics[3].served +
-                       area[3] / statistics[4].served) /
-                          4 +
-                      area[4] / statistics[5].served;
-
-    // GetSeed(&seed); //ogni volta che eseguo getSeed, ottengo lo stato del generatore
-    // printf("seed finale: %ld\n\n", seed);
-
-    return (avg_wait);
+    printf("%ld - %4.2f %%\n", s->refused, 100.0 * s->refused / s->arrivals);
+    fprintf(file, "%f\n", AvgWait(s));
+    fflush(file);
 }
 
 int main()
 {
     double t_arresto = 105; //210; //410; //820; //1640; //3280; //6560; //13110;
     long seed = 123456789;
-    double response;
+    sim_params p;
+    sim_context *s;
     FILE *file = fopen("file.txt", "w+");
     if (file == NULL)
     {
         printf("Error ");
         return 0;
     }
-    PlantSeeds(seed); // initialize plantSeeds out of the replication cycle
-    for (int i = 0; i < 100; i++)
+    DefaultParams(&p);
+    p.exact = 1;                     // the areas of the original program
+    p.event_list = EVENT_LIST;
+    p.generator = GENERATOR;
+    p.servers = SERVERS;
+    p.lambda = LAMBDA;
+    p.alpha = ALPHA;
+    p.capacity = CAPACITY;
+    p.stop = t_arresto;
+    p.purge = 0;
+
+    s = CreateSimulation(&p, seed);
+    if (s == NULL)
     {
-        /* ----------------------------------------------------------------------- *
-         * Replications loop                                                       *
-         * ----------------------------------------------------------------------- */
-        // response = transient(t_arresto, seed);
-        response = transient(t_arresto);
-        fprintf(file, "%f\n", response);
-        fflush(file);
+        printf("Error ");
+        return 0;
     }
+    ReplicateSimulation(s, REPLICATIONS, Replication, file);
     fclose(file);
+    FreeSimulation(s);
 }
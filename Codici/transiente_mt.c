@@ -0,0 +1,124 @@
+/* -------------------------------------------------------------------------- *
+ * This program makes the transient analysis of transiente.c (CAPACITY 0)     *
+ * and transiente_loss.c (CAPACITY 10) running the replications in parallel   *
+ * on all the cores, with the simulation library netsim.c.                    *
+ * Each replication r gets its own streams (arrivals, APs and switch) with    *
+ * PlantReplicationR: they are fixed and do not overlap the streams of the    *
+ * other replications, so the results in file.txt, printed in the order of    *
+ * the replications, are the same whatever the number of threads.             *
+ *                                                                            *
+ * Usage: transiente_mt.o [t_arresto [threads]]                               *
+ *                                                                            *
+ * Name            : transiente_mt.c  (Parallel Transient Analysis)           *
+ * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
+ * Language        : C                                                        *
+ * Latest Revision : 15-10-2026                                               *
+ * -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rngs.h"      // the multi-stream generator
+#include "netsim.h"    // simulation of the network
+#include "replicate.h" // parallel replications
+
+#define SEED 123456789     //initial seed of the replications
+#define REPLICATIONS 100   //number of replications
+#define T_ARRESTO 105      //210; //410; //820; //1640; //3280; //6560; //13110;
+#define LAMBDA 10          //traffic flow rate
+#define ALPHA 0.5          //shape parameter of BP Distribution
+#define CAPACITY 0         //AP queue capacity, 0 if infinite
+#define REP_STREAMS 3      //streams used by a replication
+#define GENERATOR RNG_LEHMER //RNG_MRG32K3A for more than 2000 replications
+
+typedef struct
+{
+    sim_context **context; // one simulation per thread
+    double *avg_wait;      // results of the replications
+    long *refused;
+    long *arrivals;
+} study;
+
+static void Replication(long r, int worker, void *arg)
+{
+    /* ------------------------------------------------------------------------ *
+     * one replication of the transient analysis                                *
+     * ------------------------------------------------------------------------ */
+    study *st = arg;
+    sim_context *s = st->context[worker];
+
+    PlantReplicationR(&s->rng, SEED, r, REPLICATIONS, REP_STREAMS);
+    InitSimulation(s);
+    RunSimulation(s);
+    st->avg_wait[r] = AvgWait(s);
+    st->refused[r] = s->refused;
+    st->arrivals[r] = s->arrivals;
+}
+
+int main(int argc, char *argv[])
+{
+    double t_arresto = (argc > 1) ? atof(argv[1]) : T_ARRESTO;
+    int threads = (argc > 2) ? atoi(argv[2]) : DefaultThreads();
+    sim_params p;
+    study st;
+    FILE *file;
+
+    if (threads < 1)
+        threads = 1;
+    DefaultParams(&p);
+    p.exact = 1;                     // the areas of the original program
+    p.lambda = LAMBDA;
+    p.alpha = ALPHA;
+    p.capacity = CAPACITY;
+    p.generator = GENERATOR;
+    p.stop = t_arresto;
+    p.purge = 0; // the transient analysis ends at the stopping time
+
+    st.context = malloc(threads * sizeof(sim_context *));
+    st.avg_wait = malloc(REPLICATIONS * sizeof(double));
+    st.refused = malloc(REPLICATIONS * sizeof(long));
+    st.arrivals = malloc(REPLICATIONS * sizeof(long));
+    if (st.context == NULL || st.avg_wait == NULL || st.refused == NULL ||
+        st.arrivals == NULL)
+    {
+        printf("Error: out of memory\n");
+        return 1;
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        st.context[i] = CreateSimulation(&p, SEED);
+        if (st.context[i] == NULL)
+        {
+            printf("Error: out of memory\n");
+            return 1;
+        }
+    }
+
+    if (RunReplications(REPLICATIONS, threads, Replication, &st) != 0)
+    {
+        printf("Error: cannot start the threads\n");
+        return 1;
+    }
+
+    file = fopen("file.txt", "w+");
+    if (file == NULL)
+    {
+        printf("Error");
+        return 1;
+    }
+    for (long r = 0; r < REPLICATIONS; r++)
+    {
+        fprintf(file, "%f\n", st.avg_wait[r]);
+        if (CAPACITY > 0)
+            printf("%ld - %4.2f %%\n", st.refused[r],
+                   100.0 * st.refused[r] / st.arrivals[r]);
+    }
+    fclose(file);
+
+    for (int i = 0; i < threads; i++)
+        FreeSimulation(st.context[i]);
+    free(st.context);
+    free(st.avg_wait);
+    free(st.refused);
+    free(st.arrivals);
+    return 0;
+}
@@ -7,68 +7,35 @@
  * node. The service nodes are assumed to be initially idle, no arrivals are  *
  * permitted after the terminal time STOP, and the node is then purged by     *
  * processing any remaining jobs in the service node.                         *
+ * The simulation is the one of netsim.c, on the network of nsssn_bp.c with   *
+ * SERVERS - 1 APs and Exponential service times, so that it can be checked   *
+ * against the theoretical values.                                            *
  *                                                                            *
  * Name            : nsssn_exp.c  (Network of Single-Server Service Nodes)    *
  * Authors         : D. Verde, G. A. Tummolo, G. La Delfa                     *
  * Language        : C                                                        *
- * Latest Revision : 08-09-2021                                               *
+ * Latest Revision : 15-10-2026                                               *
  * -------------------------------------------------------------------------- */
 
 #include <stdio.h>
-#include <math.h>
-#include "rngs.h" /* the multi-stream generator           */
-#include "rvgs.h" /* random variate generators            */
-#include <unistd.h>
 #include <stdbool.h>
+#include "rngs.h"     /* the multi-stream generator           */
+#include "rvgs.h"     /* random variate generators            */
+#include "evlist.h"   /* event list management                */
+#include "topology.h" /* network topology                     */
+#include "netsim.h"   /* simulation of the network            */
 
-#define START 0.0               /* initial time                             */
 #define STOP 30000.0            /* terminal (close the door) time           */
-#define INFINITE (100.0 * STOP) /* must be much larger than STOP            */
+#define EVENT_LIST EVENT_HEAP   /* event list, see evlist.h                 */
+#define GENERATOR RNG_LEHMER    /* random numbers, see rngs.h               */
 
-#define SERVERS 6               // if you change this, check rows 58,61,349
+#define SERVERS 6               /* SERVERS - 1 APs and the switch           */
 #define LAMBDA 5                /* Traffic flow rate                        */
 #define MU_AP 0.332800          /* Service rate of APs                      */
 #define MU_SWITCH 46.137344     /* Service rate of Switch                   */
 #define RUN_TESTS 0             /* Set this to 1 if you want to
                                    execute tests and print theorical values */
 
-// list where the next events are stored
-typedef struct
-{
-    double t; // next event time
-    int x;    // status: 0 (off) or 1 (on)
-} event_list[SERVERS + 1];
-
-// Clock Time
-typedef struct
-{
-    double current; // current time
-    double next;    // next-event time
-} t;
-
-// Output Statistics
-typedef struct
-{                   // aggregated sums of:
-    double service; //   service times
-    long served;    //   number of served jobs
-    long arrives;   //   arrives in the node
-
-} sum[SERVERS + 1];
-
-long number[SERVERS] = {0, 0, 0, 0, 0,0}; // number of jobs in the node
-long arrivals = 0;                      // number of arrivals
-long departures = 0;                    // number of departures
-double area[SERVERS] = {0.0, 0.0, 0.0, 0.0, 0.0,0.0};
-
-//Output Statistics Struct
-sum statistics;
-
-// Event List Management
-event_list event;
-
-// Clock Time
-t clock;
-
 double E_TQ(double lambda, double mu)
 {
 /* -------------------------------------------------------------------------- * 
@@ -90,368 +57,122 @@ double E_TS(double lambda, double mu)
     return (1 / (mu - lambda));
 }
 
-double GetArrival()
-{
-/* -------------------------------------------------------------------------- * 
- * generate the next arrival time, with rate LAMBDA                           *
- * -------------------------------------------------------------------------- */
-    static double arrival = START;
-
-    SelectStream(0);
-    arrival += Exponential(1.0 / LAMBDA);
-    return (arrival);
-}
-
-double GetService_AP()
-{
-/* -------------------------------------------------------------------------- * 
- * generate the next service time for the access points                       *
- * -------------------------------------------------------------------------- */
-    SelectStream(1);
-    return (Exponential(1.0 / MU_AP));
-}
-
-double GetService_Switch()
-{
-    /* -------------------------------------------------------------------------- * 
- * generate the next service time for the switch                              *
- * -------------------------------------------------------------------------- */
-    SelectStream(2);
-    return (Exponential(1.0 / MU_SWITCH));
-}
-
-void ProcessArrival(int index)
-{
-/* -------------------------------------------------------------------------- * 
- * function that processes arrivals                                           *
- * -------------------------------------------------------------------------- */
-    double service_time = 0.0;
-    if (number[index - 1] == 0)
-    { // if the queue is empty, serve it immediately
-        if (index == SERVERS)
-        {
-            service_time = GetService_Switch();
-        }
-        else
-        {
-            service_time = GetService_AP();
-        }
-        event[index].t = service_time + clock.current;
-        event[index].x = 1;
-        statistics[index].service += service_time;
-        statistics[index].served++;
-    }
-
-    number[index - 1]++;
-}
-
-void ProcessDeparture(int index)
-{
-/* -------------------------------------------------------------------------- * 
- * function that processes departures                                         *
- * -------------------------------------------------------------------------- */
-    double service_time = 0.0;
-    if (index < SERVERS)
-    {
-        ProcessArrival(SERVERS); // if it comes at APs send the job to the switch
-    }
-    else
-    {
-        departures++; // else the job leaves the system
-    }
-
-    number[index - 1]--;
-
-    if (number[index - 1] > 0)
-    { // schedule next departure from this node
-        if (index == SERVERS)
-        {
-            service_time = GetService_Switch();
-        }
-        else
-        {
-            service_time = GetService_AP();
-        }
-        event[index].t = service_time + clock.current;
-        event[index].x = 1;
-        statistics[index].service += service_time;
-        statistics[index].served++;
-    }
-    else
-    {
-        event[index].t = INFINITE;
-        event[index].x = 0;
-    }
-}
-
-bool empty_queues()
-{
-/*-------------------------------------------------------------------------- *
- * return false if there are jobs in the queues else retrun true             *
- * ------------------------------------------------------------------------- */
-    for (int i = 0; i < SERVERS; i++)
-    {
-        if (number[i] != 0)
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
-int NextEvent(event_list event)
-{
-/* -------------------------------------------------------------------------- *
- * return the index of the next event type                                    *
- * -------------------------------------------------------------------------- */
-    int e;
-    int i = 0;
-
-    while (event[i].x == 0) // find the index of the first active event
-        i++;
-
-    e = i;
-    while (i < SERVERS + 1)
-    { // find the most imminent event
-        i++;
-        if ((event[i].x == 1) && (event[i].t < event[e].t))
-            e = i;
-    }
-    return (e);
-}
-
 /*---------------------------------Tests--------------------------------------*/
 
-bool TestProcessArrival(int index, bool first)
+bool TestProcessArrival(sim_context *s)
 {
 /* -------------------------------------------------------------------------- *
- * Function to verify the correct implementation of ProcessArrival().         *     
- * This simulates the system in the case there is 1 job in service            *
- * (and the next will be enqueued), and in the case there is no job in        *
- * service (and the next will be served).                                     *
+ * Function to verify the correct implementation of the arrivals: the first  *
+ * event is an arrival, and the job is served immediately by an idle node,    *
+ * whose departure is scheduled.                                              *
  * -------------------------------------------------------------------------- */
-    if (first)
-    {
-        clock.next = START + GetService_AP();
-        event[index].t = clock.next;
-        statistics[index].served = 1;
-        number[index - 1] = 1;
-        ProcessArrival(index);
-        if (number[index - 1] == 2 && statistics[index].served == 1 &&
-            event[index].t == clock.next)
-        {
-            return true;
-        }
-        else
-        {
-            return false;
-        }
-    }
-    else
+    InitSimulation(s);
+    StepSimulation(s);
+    for (int i = 1; i <= SERVERS; i++)
     {
-        clock.next = START;
-        event[index].t = clock.next;
-        statistics[index].served = 0;
-        number[index - 1] = 0;
-        ProcessArrival(index);
-        if (number[index - 1] == 1 && statistics[index].served == 1 &&
-            event[index].t > clock.next)
+        if (s->number[i - 1] == 1)
         {
-            return true;
-        }
-        else
-        {
-            return false;
+            return (s->jobs == 1 && s->statistics[i].served == 1 &&
+                    EventTime(s->event, i) > s->current);
         }
     }
+    return false;
 }
 
-bool TestProcessDeparture(int index)
+bool TestProcessDeparture(sim_context *s)
 {
 /* -------------------------------------------------------------------------- *
- * Function to verify the correct implementation of ProcessDeparture().       * 
- * This simulates the system in the case there are 2 job in the system        *
- * and there is a departure from that service node.                           *  
+ * Function to verify the correct implementation of the departures: up to    *
+ * the first job that leaves the network, every job is either in a node or    *
+ * gone, and every busy node has its departure scheduled.                     *
  * -------------------------------------------------------------------------- */
-    clock.next = START + GetService_AP();
-    event[index].t = clock.next;
-    number[index - 1] = 2;
-    statistics[index].served = 1;
-    ProcessDeparture(index);
-    if (number[index - 1] == 1 && event[index].t > clock.next &&
-        statistics[index].served == 2)
-    {
-        return true;
-    }
-    else
+    long jobs = 0;
+
+    InitSimulation(s);
+    while (s->departures == 0 && StepSimulation(s))
+        ;
+    for (int i = 1; i <= SERVERS; i++)
     {
-        return false;
+        jobs += s->number[i - 1];
+        if (s->number[i - 1] > 0 && !EventActive(s->event, i))
+            return false;
     }
+    return (s->departures == 1 && jobs == s->jobs &&
+            s->arrivals == s->jobs + s->departures);
 }
 
-bool TestEmptyQueue()
+bool TestEmptyQueue(sim_context *s)
 {
 /* -------------------------------------------------------------------------- *
- * Function to verify the correct implementation of empty_queues().           *
- * This simulates the case there are some jobs in the system.                 *
+ * Function to verify the correct implementation of the end of the run: it    *
+ * is not over while there are some jobs in the system.                       *
  * -------------------------------------------------------------------------- */
-
-    for (int s = 0; s < SERVERS; s++)
-    {
-        number[s] = 5;
-    }
-
-    if (empty_queues() == false)
-    {
-        return true;
-    }
-    else
-    {
-        return false;
-    }
+    InitSimulation(s);
+    while (EventTime(s->event, 0) < STOP && StepSimulation(s))
+        ;
+    return (s->jobs == 0 || !SimulationDone(s));
 }
 
 /*-----------------------------End of Tests-----------------------------------*/
 
 int main(void)
 {
-    // Init
-    PlantSeeds(0);
-    clock.current = START;     // set the clock
-    event[0].t = GetArrival(); // schedule the first arrival
-    event[0].x = 1;
-    for (int s = 1; s <= SERVERS; s++)
-    {
-        event[s].t = INFINITE;
-        event[s].x = 0; // Departure process is off at the start
-        statistics[s].service = 0.0;
-        statistics[s].served = 0;
-    }
+    sim_params p;
+    sim_context *s;
+    topology *t;
 
-    int e = 0;
-    while ((event[0].t < STOP) || !empty_queues())
+    // the network of nsssn_bp.c, with Exponential service times
+    DefaultParams(&p);
+    p.exact = 1;                     // the areas of the original program
+    t = CampusTopology(SERVERS, p.alpha, p.ap_min, p.ap_max, p.sw_min,
+                       p.sw_max, 0);
+    if (t == NULL || ExponentialDist(&t->service[0], 1.0 / MU_AP) != 0 ||
+        ExponentialDist(&t->service[1], 1.0 / MU_SWITCH) != 0)
     {
-        e = NextEvent(event);
-        clock.next = event[e].t;
-        for (int j = 0; j < SERVERS; j++)
-        {
-            area[j] += (clock.next - clock.current) * number[j];
-        }
-
-        clock.current = clock.next;
-        if (e == 0)
-        {
-            // Process an Arrival
-            arrivals++;
-
-            double rnd = Random(); // Detect where it comes
-            int s;
-            if (rnd > 0 && rnd <= 1.0 / 25)
-            {
-                s = 1;
-            }
-            else if (rnd > 1.0 / 25 && rnd <= 2.0 / 25)
-            {
-                s = 2;
-            }
-            else if (rnd > 2.0 / 25 && rnd <= 3.0 / 25)
-            {
-                s = 3;
-            }
-            else if (rnd > 3.0 / 25 && rnd <= 4.0 / 25)
-            {
-                s = 4;
-            }
-            else if (rnd > 4.0 / 25 && rnd <= 5.0 / 25)
-            {
-                s = 5;
-            } else {
-                s = 6;
-            }
-            statistics[s].arrives++;
-            ProcessArrival(s);
-
-            event[0].t = GetArrival(); // Scheduling Next Arrival
-            if (event[0].t > STOP)
-            {
-                event[0].x = 0;
-            }
-        }
-        else
-        {
-            // Process a Departure (e indicates server number)
-            ProcessDeparture(e);
-        }
+        printf("Error: out of memory\n");
+        return (1);
     }
+    p.top = t;
+    p.stop = STOP;
+    p.event_list = EVENT_LIST;
+    p.generator = GENERATOR;
+    p.lambda = LAMBDA;
+    p.purge = 1;
 
-    // Print of Output Statistics
-    double tot_area = area[0] + area[1] + area[2] + area[3] + area[4];
-    printf("Output Statistics (computed using %ld jobs) are:\n\n", departures);
-    printf("1) Global Statistics\n");
-    printf("  avg interarrival time = %6.6f\n", event[0].t / arrivals);
-    printf("  avg waiting time = %6.6f\n", tot_area / departures);
-    printf("  avg number of jobs in the network = %6.2f\n",
-           tot_area / clock.current);
-
-    for (int s = 1; s <= SERVERS; s++)
+    s = CreateSimulation(&p, 0); // the seed is asked, as PlantSeeds(0)
+    if (s == NULL)
     {
-        tot_area -= statistics[s].service;
+        printf("Error: out of memory\n");
+        return (1);
     }
-    printf("  avg delay = %6.6f\n", tot_area / departures);
-    printf("  avg number of jobs in queues = %6.6f\n", tot_area / clock.current);
-    printf("\n");
-    printf("\n");
-
-    printf("2) Local Statistics\n");
-    printf("  server     utilization   avg service   share        ");
-    printf("avg wait      avg delay\n");
+    RunSimulation(s);
 
-    for (int s = 1; s <= SERVERS; s++)
-    {
-        if (s <= 4)
-        {
-            printf("   AP-");
-        }
-        else
-        {
-            printf("   Sw-");
-        }
-        printf("%d %13.6f %13.6f %13.6f %13.6f %13.6f\n", s,
-               statistics[s].service / clock.current,
-               statistics[s].service / statistics[s].served,
-               (double)statistics[s].arrives / arrivals,
-               area[s - 1] / statistics[s].served,
-               (area[s - 1] - statistics[s].service) / statistics[s].served);
-    }
-    double avg_wait = (area[0] / statistics[1].served +
-                       area[1] / statistics[2].served +
-                       area[2] / statistics[3].served +
-                       area[3] / statistics[4].served) /
-                          4 +
-                      area[4] / statistics[5].served;
-    printf("\n");
-    printf("  Average Waiting Time of Users: %13.6f\n", avg_wait);
+    // Print of Output Statistics
+    ReportSimulation(stdout, s);
 
     if (RUN_TESTS)
     {
+        long arrivals = s->arrivals;
+        long departures = s->departures;
+
         printf("Now, we do some tests to verify and validate the model\n");
         printf("If you see some errors, there is something that should ");
         printf("be wrong and you need to check it.\n");
 
-        printf("Test 1: function empty_queues() ");
-        if (TestEmptyQueue())
+        printf("Test 1: function SimulationDone() ");
+        if (TestEmptyQueue(s))
             printf("OK\n");
         else
             printf("Error!!!\n");
 
-        printf("Test 2: function ProcessDeparture() ");
-        if (TestProcessDeparture(1))
+        printf("Test 2: departures of StepSimulation() ");
+        if (TestProcessDeparture(s))
             printf("OK\n");
         else
             printf("Error!!!\n");
 
-        printf("Test 3: function ProcessArrival() ");
-        if (TestProcessArrival(1, 1) && TestProcessArrival(1, 0))
+        printf("Test 3: arrivals of StepSimulation() ");
+        if (TestProcessArrival(s))
             printf("OK\n");
         else
             printf("Error!!!\n");
@@ -489,5 +210,7 @@ int main(void)
         printf("  E(Ts)_User:    %10.6f\n", Ets_ap + Ets_sw);
     }
 
+    FreeSimulation(s);
+    FreeTopology(t);
     return (0);
 }